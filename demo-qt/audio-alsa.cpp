@@ -20,7 +20,6 @@
  *   demo-qt/audio-alsa.cpp: audio output with Advanced Linux Sound Architecture
  */
 
-#include <QFile>
 #include "audio.h"
 
 #include <alsa/asoundlib.h>
@@ -41,21 +40,15 @@ Audio::Audio(struct aave *aave)
 
 void Audio::run()
 {
-	/* Read the source.raw file (44100Hz 16 bits mono) into a buffer. */
-	QFile file("source.raw");
-	if (!file.open(QIODevice::ReadOnly)) {
-		fprintf(stderr, "Error opening source.raw\n");
-		return;
-	}
-	unsigned bufhead = 0;
-	unsigned bufsize = file.size() / 2;
-	short *buf = new short[bufsize];
-	memset(buf, 0, bufsize * sizeof(short));
-	if (file.read((char *)buf, file.size()) != file.size()) {
+	/*
+	 * Map the source.raw file (44100Hz 16 bits mono) in memory,
+	 * and play it in a loop from the sound source.
+	 */
+	struct aave_source *source = aave->sources;
+	if (aave_set_source_file(source, "source.raw", 1) < 0) {
 		fprintf(stderr, "Error reading source.raw\n");
 		return;
 	}
-	file.close();
 
 	/* Open the ALSA audio device. */
 	 const char device[] = "default";
@@ -76,24 +69,7 @@ void Audio::run()
 		return;
 	}
 
-	struct aave_source *source = aave->sources;
-
-	unsigned n;
 	for (;;) {
-		/*
-		 * Put this number of frames of the anechoic sound buffer
-		 * into the sound source buffer (loop if necessary).
-		 */
-		for (unsigned i = 0; i < FRAMES; i += n) {
-			n = FRAMES - i;
-			if (n > bufsize - bufhead)
-				n = bufsize - bufhead;
-			aave_put_audio(source, buf + bufhead, n);
-			bufhead += n;
-			if (bufhead == bufsize)
-				bufhead = 0;
-		}
-
 		/* Get the frames of binaural data from the engine. */
 		aave_get_audio(aave, buffer, FRAMES);
 
@@ -20,7 +20,6 @@
  *   demo-qvtk/audio-alsa.cpp: audio output with Advanced Linux Sound Architecture
  */
 
-#include <QFile>
 #include "audio.h"
 #include "global.h"
 #include <alsa/asoundlib.h>
@@ -30,9 +29,6 @@
 #define NSOURCES 1
 
 char* sources[] = {"../sounds/piano.raw"};
-unsigned nBufhead[NSOURCES];
-unsigned nBufsize[NSOURCES];
-short* nBuf[NSOURCES];
 
 Audio::Audio(struct aave *aave)
     : QThread()
@@ -43,23 +39,17 @@ Audio::Audio(struct aave *aave)
 
 void Audio::run()
 {
-    /* Read the source.raw file (44100Hz 16 bits mono) into a buffer. */
-    for (int i = 0; i < NSOURCES;i++) {
-
-        QFile file(sources[i]);
-        if (!file.open(QIODevice::ReadOnly)) {
-            fprintf(stderr, "Error opening source.raw\n");
-            return;
-        }
-        nBufhead[i] = 0;
-        nBufsize[i] = file.size() / 2;
-        nBuf[i] = new short[nBufsize[i]];
-        memset(nBuf[i], 0, nBufsize[i] * sizeof(short));
-        if (file.read((char *)nBuf[i], file.size()) != file.size()) {
-            fprintf(stderr, "Error reading source.raw\n");
+    /*
+     * Map the source files (44100Hz 16 bits mono) in memory,
+     * and play them in a loop from the sound sources.
+     */
+    struct aave_source *source = aave->sources;
+    for (int i = 0; i < NSOURCES && source; i++) {
+        if (aave_set_source_file(source, sources[i], 1) < 0) {
+            fprintf(stderr, "Error reading %s\n", sources[i]);
             return;
         }
-        file.close();
+        source = source->next;
     }
 
     /* Open the ALSA audio device. */
@@ -80,29 +70,7 @@ void Audio::run()
         return;
     }
 
-    unsigned n;
     for (;;) {
-        /*
-         * Put this number of frames of the anechoic sound buffer
-         * into the sound source buffer (loop if necessary).
-         */
-
-        struct aave_source *source = aave->sources;
-
-        for (int j = 0; j < NSOURCES;j++) {
-
-            for (unsigned i = 0; i < FRAMES; i += n) {
-                n = FRAMES - i;
-                if (n > nBufsize[j] - nBufhead[j])
-                    n = nBufsize[j] - nBufhead[j];
-                aave_put_audio(source, nBuf[j] + nBufhead[j], n);
-                nBufhead[j] += n;
-                if (nBufhead[j] == nBufsize[j])
-                    nBufhead[j] = 0;
-            }
-            source=source->next;
-        }
-
         /* Get the frames of binaural data from the engine. */
         aave_get_audio(aave, buffer, FRAMES);
 
@@ -150,9 +150,15 @@
  * head-related transfer function (HRTF) processing, and generating
  * the corresponding auralised audio data in binaural format.
  *
+ * The file ambisonics.c implements an alternative to the per-sound HRTF
+ * processing, where the sounds are encoded into an Ambisonics bus that
+ * is decoded to binaural with a fixed number of HRTF filters.
+ *
  * The files hrtf_cipic.c, hrtf_listen.c, hrtf_mit.c, and hrtf_tub.c
  * implement the interface functions for using the
  * CIPIC, LISTEN, MIT, and TU-Berlin HRTF sets, respectively.
+ * The file hrtf_file.c implements the interface for using HRTF sets
+ * read from HRTF files, mapped in memory, selectable while running.
  *
  * The files dft.h and idft.h implement the Discrete Fourier Transform
  * and Inverse Discrete Fourier Transform algorithms,
@@ -163,12 +169,19 @@
  * the table of material reflection coefficients by frequency band,
  * the table lookup, and the design of the audio filters.
  *
+ * The file quality.c implements a feedback controller that adapts the
+ * order of reflections, the number of sounds rendered and the order of the
+ * late reverberation to the processing time available, measured while
+ * running.
+ *
  * The file reverb.c implements a simple artificial reverberation algorithm
  * that adds a tail of late reflections to the auralisation output.
  * The file reverb_dattorro.c implements the Dattorro reverberator.
  *
  * The directory tools contains the programs used to automatically generate
  * the hrtf_*_set*.c source files from the respective HRTF data sets,
+ * the programs that write those sets, or SOFA (AES69) HRIR sets, to HRTF
+ * files,
  * the dftsincos.c source file with the sin() and cos() lookup table
  * for the DFT and IDFT algorithms, and miscellaneous utility programs
  * to handle or generate audio files.
@@ -237,6 +250,92 @@
  */
 #define AAVE_MAX_REFLECTIONS 16
 
+/**
+ * Reflection order level of detail policies of a sound source,
+ * selected with aave_set_source_lod():
+ * - AAVE_LOD_GLOBAL: calculate reflections up to aave->reflections
+ *   (the default);
+ * - AAVE_LOD_FIXED: calculate reflections up to a fixed order per source;
+ * - AAVE_LOD_DISTANCE: calculate one order less for each doubling of the
+ *   distance from the source to the listener beyond aave->lod_distance
+ *   (6 dB less direct sound level);
+ * - AAVE_LOD_PRIORITY: calculate as many orders less as the priority
+ *   of the source (0 is the highest priority).
+ *
+ * The order of reflections is always limited to aave->reflections.
+ */
+#define AAVE_LOD_GLOBAL 0
+#define AAVE_LOD_FIXED 1
+#define AAVE_LOD_DISTANCE 2
+#define AAVE_LOD_PRIORITY 3
+
+/**
+ * The default reference distance (m) of the AAVE_LOD_DISTANCE policy,
+ * used when aave->lod_distance is 0.
+ */
+#define AAVE_LOD_REFERENCE_DISTANCE 2
+
+/**
+ * Rendering modes of the sounds of each reflection order,
+ * selected with aave_set_render():
+ * - AAVE_RENDER_HRTF: each sound is multiplied by its own HRTF pair
+ *   (the default);
+ * - AAVE_RENDER_CLUSTER: the sounds that resolve to the same HRTF pair
+ *   are summed first, and each sum is multiplied by the HRTF pair
+ *   once per audio block;
+ * - AAVE_RENDER_AMBISONICS: the sounds are encoded into an Ambisonics bus,
+ *   which is decoded to binaural once per audio block (see ambisonics.c);
+ * - AAVE_RENDER_COARSE: as AAVE_RENDER_CLUSTER, but with the direction of
+ *   the sounds rounded to a grid of AAVE_COARSE_STEP degrees, so that
+ *   many more sounds share the same HRTF pair.
+ */
+#define AAVE_RENDER_HRTF 0
+#define AAVE_RENDER_CLUSTER 1
+#define AAVE_RENDER_AMBISONICS 2
+#define AAVE_RENDER_COARSE 3
+
+/**
+ * Step (degrees) of the grid of directions of the AAVE_RENDER_COARSE mode.
+ * Late reflections cannot be localised precisely, so a step larger than
+ * the resolution of the HRTF sets goes unnoticed.
+ */
+#define AAVE_COARSE_STEP 30
+
+/**
+ * Size of the direction lookup table of the HRTF sets (see hrtf_lookup.c):
+ * the unit sphere is mapped to a grid of AAVE_HRTF_LOOKUP_SIZE by
+ * AAVE_HRTF_LOOKUP_SIZE cells, about 1.6 degrees wide on average.
+ */
+#define AAVE_HRTF_LOOKUP_SIZE 128
+
+/**
+ * States of @p aave->hrtf_delays: an HRTF set with delays was selected,
+ * and then the sounds have the DFT of their right ear (see aave_update()).
+ */
+#define AAVE_HRTF_DELAYS_SELECTED 1
+#define AAVE_HRTF_DELAYS_READY 2
+
+/**
+ * The order of the Ambisonics bus of the AAVE_RENDER_AMBISONICS mode
+ * (1 to 3). Each order adds 2 * order + 1 channels to the bus, that is,
+ * a real multiply-add per DFT bin per sound.
+ */
+#ifndef AAVE_AMBISONICS_ORDER
+#define AAVE_AMBISONICS_ORDER 1
+#endif
+
+/** The number of channels of the Ambisonics bus. */
+#define AAVE_AMBISONICS_CHANNELS \
+		((AAVE_AMBISONICS_ORDER + 1) * (AAVE_AMBISONICS_ORDER + 1))
+
+/**
+ * The maximum number of direction clusters per audio block in the
+ * AAVE_RENDER_CLUSTER mode (each HRTF pair makes up to 3 clusters, one per
+ * DFT bus). When there are more, the remaining sounds are rendered
+ * as in the AAVE_RENDER_HRTF mode. Must be less than 256.
+ */
+#define AAVE_MAX_CLUSTERS 128
+
 /**
  * The maximum number of frames of an HRTF.
  * (The longest HRTFs are TU-Berlin's: 2048).
@@ -249,6 +348,20 @@
  */
 #define AAVE_MAX_HRTF 2048
 
+/**
+ * Storage type of the spectra of the HRTFs, as the audio processing uses
+ * them (see hrtf_lookup.c), and of the sounds: float or, if AAVE_BF16 is
+ * defined, bfloat16, the upper 16 bits of a float, with its range and an
+ * 8-bit significand (quantisation noise about 50 dB below the signal).
+ * With many sounds, the complex multiply-adds of the spectra are bound by
+ * memory bandwidth, which bfloat16 halves; they convert to float on load.
+ */
+#ifdef AAVE_BF16
+typedef unsigned short aave_spectrum;
+#else
+typedef float aave_spectrum;
+#endif
+
 /**
  * The number of past anechoic samples to hold for each sound source.
  * This effectively defines the maximum distance that can be auralised:
@@ -262,6 +375,20 @@
  */
 #define AAVE_SOURCE_BUFSIZE 131072
 
+/**
+ * Full scale of the samples processed by the library: float samples
+ * in the range [-1;1] (aave_put_audio_f32(), aave_get_audio_f32())
+ * are processed in the range of 16-bit samples.
+ */
+#define AAVE_F32_SCALE 32768
+
+/**
+ * The highest absolute value of the anechoic samples of the sound sources
+ * considered silence. The sounds whose samples are all silent are not
+ * processed (see aave_put_audio()).
+ */
+#define AAVE_SILENCE_LEVEL 0
+
 /**
  * The number of reflection factors that specify each material.
  * The corresponding frequencies are:
@@ -277,10 +404,245 @@
 #define AAVE_SOUND_SPEED 343.2
 
 /**
- * The order of the circulation matrix for the FDN late reverberator.
+ * The maximum order of the circulation matrix for the FDN late reverberator
+ * (see aave_reverb_set_order()).
  */
 #define FDN_ORDER 64
 
+/**
+ * The size of the ring of each delay line of the FDN late reverberator,
+ * in samples. Must be a power of 2, larger than the longest delay line
+ * plus the block size of the FDN.
+ */
+#define AAVE_REVERB_LINE_SIZE 2048
+
+/**
+ * The block size of the shortest partitions of the convolution late
+ * reverberator, in samples: the delay it adds to the late impulse
+ * response, taken from the pre-delay. Must be a power of 2.
+ */
+#define AAVE_REVERB_CONV_BLOCK 256
+
+/**
+ * The number of partition sizes of the convolution late reverberator,
+ * each twice the previous one; the largest is used for the rest of the
+ * late impulse response.
+ */
+#define AAVE_REVERB_CONV_LEVELS 4
+
+/**
+ * The size of the input and output rings of the convolution late
+ * reverberator, in samples: twice the largest partition.
+ */
+#define AAVE_REVERB_CONV_RING (AAVE_REVERB_CONV_BLOCK << AAVE_REVERB_CONV_LEVELS)
+
+/**
+ * The maximum length of the late impulse responses synthesised by
+ * aave_reverb_conv_init(), in samples (8 seconds).
+ */
+#define AAVE_REVERB_CONV_MAX_LENGTH (8 * AAVE_FS)
+
+/**
+ * The size of the rings of the Dattorro late reverberator, in samples.
+ * Must be a power of 2, larger than the longest delay plus the block size
+ * of the reverberator.
+ */
+#define AAVE_DATTORRO_RING 8192
+
+/** Version of the HRTF file format (see hrtf_file.c). */
+#define AAVE_HRTF_FILE_VERSION 1
+
+/**
+ * Header of an HRTF file (see hrtf_file.c), followed by the direction
+ * index and, at @p offset, the spectra. All values are in the byte order
+ * of the machine that wrote the file.
+ */
+struct aave_hrtf_file_header {
+
+	/** "AAVEHRTF". */
+	char magic[8];
+
+	/** Version of the format (AAVE_HRTF_FILE_VERSION). */
+	unsigned version;
+
+	/**
+	 * Number of frames of the HRTFs (aave->hrtf_frames): each spectrum
+	 * has 4 * @p frames floats, in the layout of dft.h.
+	 */
+	unsigned frames;
+
+	/** Number of spectra. */
+	unsigned count;
+
+	/**
+	 * Step of the direction index, in degrees (a divisor of 90): the
+	 * index has the left and right spectra of each elevation from -90 to
+	 * 90 degrees, and, in each, of each azimuth from -180 to 180 degrees.
+	 */
+	unsigned step;
+
+	/** Offset of the spectra from the start of the file, in bytes. */
+	unsigned offset;
+
+	/**
+	 * Offset of the delays of the spectra from the start of the file,
+	 * in bytes, or 0 if the spectra include their delays. The delays
+	 * are one float per spectrum, in samples (see hrtf_minphase.c).
+	 */
+	unsigned delays;
+};
+
+/**
+ * HRTF set read from an HRTF file, implemented in hrtf_file.c.
+ */
+struct aave_hrtf_file {
+
+	/** The file mapped in memory. */
+	const unsigned char *data;
+
+	/** Size of the file, in bytes. */
+	unsigned long size;
+
+	/** Header of the file. */
+	const struct aave_hrtf_file_header *header;
+
+	/** Direction index: left and right spectra of each direction. */
+	const unsigned (*index)[2];
+
+	/** The spectra. */
+	const float *spectra;
+
+	/** The delays of the spectra, in samples, or NULL. */
+	const float *delays;
+
+	/** Number of azimuths in each elevation of the index. */
+	unsigned azimuths;
+};
+
+struct aave;
+
+/**
+ * Direction lookup table of an HRTF set, implemented in hrtf_lookup.c:
+ * the HRTF pair of each cell of an octahedral map of the unit sphere.
+ */
+struct aave_hrtf_lookup {
+
+	/** The HRTF set the table was built for. */
+	void (*hrtf_get)(const struct aave *, const float *hrtf[2],
+					int elevation, int azimuth);
+
+	/** The HRTF file of the set, if any, released with the table. */
+	struct aave_hrtf_file *hrtf_file;
+
+	/** The number of frames of the HRTFs of the set. */
+	unsigned hrtf_frames;
+
+	/** The audio block from which the table is no longer in use. */
+	unsigned long block;
+
+	/** The next table no longer in use (see hrtf_lookup.c). */
+	struct aave_hrtf_lookup *next;
+
+	/** The HRTF pair of each cell, or NULL across a boundary of two pairs. */
+	const aave_spectrum *hrtf[AAVE_HRTF_LOOKUP_SIZE * AAVE_HRTF_LOOKUP_SIZE][2];
+
+	/** The delays of the HRTF pair of each cell (see aave_hrtf_delay()). */
+	float delay[AAVE_HRTF_LOOKUP_SIZE * AAVE_HRTF_LOOKUP_SIZE][2];
+
+	/**
+	 * Binaural decoder of the Ambisonics bus for the set, the filter
+	 * pair of each channel (see aave_ambisonics_decoder()), stored
+	 * atomically, or NULL while the Ambisonics mode is not in use.
+	 */
+	float (*decoder)[2][AAVE_MAX_HRTF * 4];
+
+	/** The bfloat16 copies of the spectra of the set (AAVE_BF16). */
+	aave_spectrum *data;
+
+	/** The spectra of the set copied to @p data, in order (AAVE_BF16). */
+	const float **spectra;
+
+	/**
+	 * Hash table of the spectra of the set, for the cells with no pair:
+	 * their index in @p spectra plus 1, or 0 (AAVE_BF16).
+	 */
+	unsigned *hash;
+
+	/** The number of entries of @p hash, a power of 2, minus 1. */
+	unsigned mask;
+};
+
+/**
+ * Late reverberation engines (see aave_reverb_set_engine()):
+ * - AAVE_REVERB_NONE: no late reverberation;
+ * - AAVE_REVERB_JOT: Jot feedback delay network, reverb_jot.c
+ *   (the default);
+ * - AAVE_REVERB_DATTORRO: Dattorro plate reverberator, reverb_dattorro.c,
+ *   cheaper, but not parameterised by the room;
+ * - AAVE_REVERB_CONV: convolution with a late impulse response,
+ *   reverb_conv.c.
+ */
+#define AAVE_REVERB_NONE 0
+#define AAVE_REVERB_JOT 1
+#define AAVE_REVERB_DATTORRO 2
+#define AAVE_REVERB_CONV 3
+
+/**
+ * State of the adaptive quality controller, implemented in quality.c.
+ */
+struct aave_quality {
+
+	/** Target processing load (fraction of real time), 0 if disabled. */
+	float target;
+
+	/** Processing load measured in the last control period. */
+	float load;
+
+	/** Processing time accumulated in the current control period (s). */
+	double busy;
+
+	/** Audio time produced in the current control period (s). */
+	double audio;
+
+	/** Processing time accumulated in the current HRTF block (s). */
+	double block_busy;
+
+	/** Frames produced in the current HRTF block. */
+	unsigned block_frames;
+
+	/**
+	 * Processing time of aave_update() not yet accounted (us), added
+	 * atomically by the thread that updates the world and taken by the
+	 * audio thread (see aave_quality_account()).
+	 */
+	unsigned long update;
+
+	/**
+	 * Order of reflections selected by the controller on the audio
+	 * thread, read atomically and applied by aave_update() (see
+	 * aave_quality_apply()).
+	 */
+	unsigned reflections;
+
+	/**
+	 * FDN order of the Jot late reverberation selected by the controller,
+	 * requested with aave_reverb_set_order().
+	 */
+	unsigned reverb_order;
+
+	/** Highest order of reflections the controller may select. */
+	unsigned max_reflections;
+
+	/** Highest FDN order the controller may select. */
+	unsigned max_reverb_order;
+
+	/** Largest render budget the controller may select (0 for no limit). */
+	unsigned max_sounds;
+
+	/** Number of sounds rendered in the last audio block. */
+	unsigned sounds;
+};
+
 /**
  * The AcousticAVE main data structure. It contains all the information
  * that defines one acoustic world and its present auralisation state.
@@ -320,7 +682,18 @@ struct aave {
 	/** Maximum number of reflections to calculate for each source. */
 	unsigned reflections;
 
-    /** Flag to signal the use of artificial reverberation tail. */
+	/**
+	 * Reference distance (m) up to which the sources with the
+	 * AAVE_LOD_DISTANCE policy get all orders of reflections
+	 * (0 for AAVE_LOD_REFERENCE_DISTANCE).
+	 */
+	float lod_distance;
+
+    /**
+     * Flag to signal the use of artificial reverberation tail, set by
+     * aave_reverb_set_engine() and read atomically once per call of
+     * aave_get_audio().
+     */
     unsigned short reverb_active;
 
 	/** Late reverberation parameters. */
@@ -329,20 +702,66 @@ struct aave {
 	/** Gain to apply to the output sound. */
 	float gain;
 
+	/**
+	 * Maximum number of sounds to render per audio block (0 for no limit).
+	 * The sounds with the lowest estimated level above this budget
+	 * fade out until they rank within the budget again.
+	 */
+	unsigned max_sounds;
+
+	/** Adaptive quality controller state (see aave_quality()). */
+	struct aave_quality quality;
+
+	/** Rendering mode of the sounds of each reflection order. */
+	unsigned char render[AAVE_MAX_REFLECTIONS];
+
+	/** Direction clusters, allocated by aave_set_render(). */
+	struct aave_cluster *clusters;
+
+	/** Number of direction clusters in use in the current audio block. */
+	unsigned nclusters;
+
+	/** Hash table of the clusters in use (cluster index + 1, or 0). */
+	unsigned char cluster_hash[AAVE_MAX_CLUSTERS * 2];
+
+	/** Ambisonics bus, allocated by aave_set_render(). */
+	struct aave_ambisonics *ambisonics;
+
 	/** The number of frames of the HRTFs currently in use (power of 2). */
 	unsigned hrtf_frames;
 
 	/** Function to get the HRTF pair for some elevation and azimuth. */
-	void (*hrtf_get)(const float *hrtf[2], int elevation, int azimuth);
+	void (*hrtf_get)(const struct aave *, const float *hrtf[2],
+					int elevation, int azimuth);
+
+	/** HRTF set read from a file (see aave_hrtf_file()), or NULL. */
+	struct aave_hrtf_file *hrtf_file;
+
+	/** Direction lookup table of the HRTF set (see hrtf_lookup.c). */
+	struct aave_hrtf_lookup *hrtf_lookup;
+
+	/** Queue of the HRTF sets selected (see hrtf_lookup.c). */
+	struct aave_hrtf_queue *hrtf_queue;
+
+	/**
+	 * State of the @p dft_right of the sounds, accessed atomically: 0
+	 * until an HRTF set with delays is selected, then
+	 * AAVE_HRTF_DELAYS_SELECTED until aave_update() allocated them, and
+	 * AAVE_HRTF_DELAYS_READY.
+	 */
+	int hrtf_delays;
 
 	/** Index of the next frame of the HRTF output buffer to be consumed. */
 	unsigned hrtf_output_buffer_index;
 
-	/** HRTF audio block output buffer (2 16-bit channels interleaved). */
-	short hrtf_output_buffer[AAVE_MAX_HRTF * 4];
+	/**
+	 * HRTF audio block output buffer (2 channels interleaved,
+	 * in the range of 16-bit samples, unclipped).
+	 */
+	float hrtf_output_buffer[AAVE_MAX_HRTF * 4];
 
-	/** HRTF overlap-add buffer (2 32-bit channels). */
-	int hrtf_overlap_add_buffer[2][AAVE_MAX_HRTF * 2];
+	/** HRTF overlap-save buffer: DFT bus 2 of the previous block (2 channels). */
+	float hrtf_overlap_save_buffer[2][AAVE_MAX_HRTF * 4];
 };
 
 /**
@@ -359,11 +778,73 @@ struct aave_source {
 	/** Position of the source in the auralisation world [x,y,z] (m). */
 	float position[3];
 
-	/** Index of the most recently inserted sample. */
+	/** Reflection order level of detail policy (AAVE_LOD_*). */
+	unsigned lod;
+
+	/**
+	 * Parameter of the level of detail policy: the maximum order of
+	 * reflections for AAVE_LOD_FIXED, or the priority for AAVE_LOD_PRIORITY.
+	 */
+	unsigned lod_param;
+
+	/** Order of reflections currently calculated, set by aave_update(). */
+	unsigned reflections;
+
+	/**
+	 * Index of the most recently inserted sample (in the ring buffer,
+	 * or in the samples read from memory).
+	 */
 	unsigned buffer_index;
 
-	/** Ring buffer to store the recent past anechoic samples. */
-	short buffer[AAVE_SOURCE_BUFSIZE];
+	/**
+	 * Number of most recently inserted samples that are silent (up to
+	 * AAVE_SOURCE_BUFSIZE), updated by aave_put_audio().
+	 */
+	unsigned silence;
+
+	/**
+	 * Ring buffer to store the recent past anechoic samples
+	 * (AAVE_SOURCE_BUFSIZE samples in the range of 16-bit samples),
+	 * allocated by aave_init_source(), released when the samples are
+	 * read from memory, or NULL.
+	 *
+	 * The samples are floats, 4 * AAVE_SOURCE_BUFSIZE bytes (512 KB)
+	 * per source, twice the size of 16-bit samples, so that the samples
+	 * put with aave_put_audio_f32() keep their headroom above full scale
+	 * and their resolution below the 16-bit step, and the resampler reads
+	 * a single sample type, with no per-sample conversion or branch.
+	 * The sources whose samples are read from memory (see source.c) have
+	 * no ring buffer, and a smaller AAVE_SOURCE_BUFSIZE halves the size
+	 * when the maximum distance allows.
+	 */
+	float *buffer;
+
+	/**
+	 * Anechoic samples read from memory instead of the ring buffer
+	 * (see source.c), or 0.
+	 */
+	const short *samples;
+
+	/** Number of samples pointed by @p samples. */
+	unsigned nsamples;
+
+	/** 1 if @p samples are repeated, 0 otherwise. */
+	int loop;
+
+	/**
+	 * The file mapped in memory (loaded, on Windows) by
+	 * aave_set_source_file() that @p samples point into, or 0.
+	 */
+	void *mapping;
+
+	/** Size of @p mapping, in bytes. */
+	unsigned long mapping_size;
+
+	/**
+	 * Streaming file the anechoic samples are read ahead from into the
+	 * ring buffer (see stream.c), or 0.
+	 */
+	struct aave_stream *stream;
 };
 
 /**
@@ -446,6 +927,21 @@ struct aave_sound {
 	/** Flag that indicates if the sound is audible (1) or not (0). */
 	int audible;
 
+	/** Flag that indicates if the sound is over the render budget. */
+	int culled;
+
+	/** Estimated level of the sound, to rank it for the render budget. */
+	float level;
+
+	/** Average gain of the material absorption filter. */
+	float filter_gain;
+
+	/**
+	 * Stride of the band-limited processing: only the lowest 1 / stride
+	 * of the band of the sound is processed (1 for the full band).
+	 */
+	unsigned stride;
+
 	/**
 	 * The previous fade-in/out sample count value used
 	 * (for the fade-in/out of appearing/disappearing sounds).
@@ -455,11 +951,35 @@ struct aave_sound {
 	/** The previous distance value used (for the crossfading). */
 	float distance;
 
+	/** Distance to the listener for the current block. */
+	float distance_current;
+
+	/**
+	 * Direction for the current block: unit vector from the listener,
+	 * in the axes of the listener (see aave_get_directions()).
+	 */
+	float direction[3];
+
 	/** Smooth (low-pass filtered) distance value (for the resampling). */
 	float distance_smooth;
 
+	/**
+	 * Smooth distance value of the right ear, when the HRTF set has
+	 * delays (for the resampling of @p dft_right).
+	 */
+	float distance_smooth_right;
+
+	/** Flag that indicates if @p dft_right holds the previous block. */
+	int ears;
+
+	/** Flag that indicates if the DFT of the previous block is zero. */
+	int silent;
+
 	/** The previous HRTF pair used (for the crossfading). */
-	const float *hrtf[2];
+	const aave_spectrum *hrtf[2];
+
+	/** The previous Ambisonics encoding gains used (for the crossfading). */
+	float ambisonics[AAVE_AMBISONICS_CHANNELS];
 
 	/** The surfaces where this sound reflects. */
 	struct aave_surface *surfaces[AAVE_MAX_REFLECTIONS];
@@ -471,10 +991,57 @@ struct aave_sound {
 	float reflection_points[AAVE_MAX_REFLECTIONS][3];
 
 	/** The DFT of the previous audio block. */
-	float dft[AAVE_MAX_HRTF * 4];
+	aave_spectrum dft[AAVE_MAX_HRTF * 4];
+
+	/**
+	 * The DFT of the previous audio block of the right ear, when the
+	 * HRTF set has delays and they differ between the ears (see @p ears),
+	 * allocated by aave_update() once a set with delays is selected, or
+	 * NULL.
+	 */
+	aave_spectrum *dft_right;
 
 	/** The material absorption filter DFT. */
-	float filter[AAVE_MAX_HRTF * 4];
+	aave_spectrum filter[AAVE_MAX_HRTF * 4];
+};
+
+/**
+ * Sum of the sounds that are rendered with the same HRTF pair to
+ * the same DFT bus, in the AAVE_RENDER_CLUSTER mode.
+ */
+struct aave_cluster {
+
+	/** The HRTF pair of the sounds in this cluster. */
+	const aave_spectrum *hrtf[2];
+
+	/** The DFT bus the cluster is added to. */
+	unsigned bus;
+
+	/** Flag that indicates if @p dft_right is in use. */
+	int ears;
+
+	/** Sum of the gain-weighted, filtered DFT of the sounds. */
+	float dft[AAVE_MAX_HRTF * 4];
+
+	/** Sum of the DFT of the right ear, of sounds with delays. */
+	float dft_right[AAVE_MAX_HRTF * 4];
+};
+
+/**
+ * Ambisonics bus of the AAVE_RENDER_AMBISONICS mode. Its binaural decoder
+ * belongs to the HRTF set (see struct aave_hrtf_lookup).
+ */
+struct aave_ambisonics {
+
+	/** Flag that indicates if sounds were added to the bus (1) or not (0). */
+	int active;
+
+	/**
+	 * The previous and current audio blocks of the sounds, one after
+	 * the other, processed with the previous (0) and current (1)
+	 * parameters, of each channel.
+	 */
+	float bus[2][AAVE_AMBISONICS_CHANNELS][AAVE_MAX_HRTF * 4];
 };
 
 /**
@@ -489,6 +1056,134 @@ struct aave_material {
 	const unsigned char reflection_factors[AAVE_MATERIAL_REFLECTION_FACTORS];
 };
 
+/**
+ * Data of a tone correction (high pass) filter.
+ */
+struct aave_tone_correction_filter {
+
+	/** Previous output of the filter (y[n-1]). */
+	float y;
+};
+
+/**
+ * Data of a dc block filter for a rough reverb highpass.
+ * @todo Improve bandwidth definition.
+ */
+struct aave_dc_block_filter {
+
+	/** Previous output of the filter (y[n-1]). */
+	float y;
+
+	/** Previous input of the filter (x[n-1]). */
+	float x;
+
+	/** Bandwidth. */
+	float b;
+};
+
+/**
+ * Data of a tank (decay block) of the Dattorro reverberator.
+ * The output taps of the tank are read from its rings.
+ */
+struct aave_dattorro_tank {
+
+	/** Previous output of the damping low-pass filter. */
+	float lp;
+
+	/** Ring of the decay diffusion all-pass filter. */
+	float ap0[AAVE_DATTORRO_RING];
+
+	/** Ring of the first delay line (output of @p ap0). */
+	float delay0[AAVE_DATTORRO_RING];
+
+	/** Ring of the damped and decayed output of @p delay0. */
+	float damped[AAVE_DATTORRO_RING];
+
+	/** Ring of the second decay diffusion all-pass filter. */
+	float ap1[AAVE_DATTORRO_RING];
+
+	/** Ring of the second delay line (output of @p ap1). */
+	float delay1[AAVE_DATTORRO_RING];
+};
+
+/**
+ * State of the Dattorro reverberator, implemented in reverb_dattorro.c.
+ */
+struct aave_dattorro {
+
+	/** Index of the next sample written to the rings (all rings). */
+	unsigned index;
+
+	/** Previous output of the input low-pass filter. */
+	float lp;
+
+	/** Rings of the input diffusion all-pass filters. */
+	float ap[4][AAVE_DATTORRO_RING];
+
+	/** The left and right tanks. */
+	struct aave_dattorro_tank tank[2];
+};
+
+/**
+ * Partitions of one block size of the convolution late reverberator.
+ */
+struct aave_reverb_conv_level {
+
+	/** Size of the input blocks and partitions (samples). */
+	unsigned size;
+
+	/** Number of partitions. */
+	unsigned partitions;
+
+	/** Index of the newest input block in @p x. */
+	unsigned index;
+
+	/**
+	 * Frequency-domain delay line: the DFTs (of size 2 * @p size) of
+	 * the last @p partitions input blocks, a ring.
+	 */
+	float *x;
+
+	/**
+	 * The DFTs (of size 2 * @p size) of the partitions of the left and
+	 * right impulse responses, interleaved by partition.
+	 */
+	float *h;
+
+	/**
+	 * The left and right output spectra (of size 2 * @p size) of the
+	 * next block, accumulated from the older input blocks of @p x while
+	 * the newest one is being input (see aave_reverb_conv()).
+	 */
+	float *y;
+};
+
+/**
+ * State of the convolution late reverberator, implemented in
+ * reverb_conv.c.
+ */
+struct aave_reverb_conv {
+
+	/** Number of input samples processed. */
+	unsigned count;
+
+	/** Partitions of each block size, shortest first. */
+	struct aave_reverb_conv_level level[AAVE_REVERB_CONV_LEVELS];
+
+	/** Ring of the input, the sum of the sources. */
+	float input[AAVE_REVERB_CONV_RING];
+
+	/** Rings of the left and right outputs, overlap-added. */
+	float output[2][AAVE_REVERB_CONV_RING];
+
+	/** Next convolution reverberator retired, or NULL. */
+	struct aave_reverb_conv *next;
+};
+
+/**
+ * State of the late reverberation unit, allocated by aave_reverb_init(),
+ * so that each auralisation world has its own.
+ */
 struct aave_reverb {
 
     /** Room volume (m3). */
@@ -506,14 +1201,14 @@ struct aave_reverb {
 	/** Crital distance at which the direct sound preassure is equal to the reverberation sound pressure. */
 	float rc;
 
-	/** Reverb predelay (samples). Sum of perceptual delay (Tmixing) and latency due to HRTF buffering. */
+	/** Reverb predelay (samples), read directly from the sources. Sum of perceptual delay (Tmixing) and latency due to HRTF buffering. */
 	float pre_delay;
 
 	/** alpha = Tr(pi) / Tr(0). Ratio of the RT at the Nyquist frequency and the DC frequency. */
 	float alpha;
 
 	/** Decorrelation coeficients for producing a decorrelated stereo output.  */
-	short decorrelation_coefs[FDN_ORDER][2];
+	float decorrelation_coefs[FDN_ORDER][2];
 
 	/** beta = 1 - sqrt(alpha) / 1 + sqrt(alpha). Bandwidth coeficient for the tone correction (highpass) filter. */
 	float beta;
@@ -532,11 +1227,88 @@ struct aave_reverb {
 
 	/** Gain/attenuation for managing the level of the late reverberation. */
 	float level;
+
+	/** Tone correction filters of the left and right outputs. */
+	struct aave_tone_correction_filter tcf[2];
+
+	/** DC block filters of the left and right outputs. */
+	struct aave_dc_block_filter dcbf[2];
+
+	/** Order of the FDN (number of delay lines in use). */
+	unsigned order;
+
+	/**
+	 * Order of the FDN requested with aave_reverb_set_order(), stored
+	 * atomically and applied by the audio thread (see
+	 * aave_reverb_apply_order()), or 0.
+	 */
+	unsigned next_order;
+
+	/** Delays of the FDN lines (samples), shortest first. */
+	unsigned short delays[FDN_ORDER];
+
+	/** Previous outputs of the absorption filters of the FDN lines. */
+	float absorption[FDN_ORDER];
+
+	/** Index of the next sample written to the FDN lines (all lines). */
+	unsigned line_index;
+
+	/** Rings of the FDN lines. */
+	float lines[FDN_ORDER][AAVE_REVERB_LINE_SIZE];
+
+	/** State of the Dattorro reverberator. */
+	struct aave_dattorro dattorro;
+
+	/** State of the convolution reverberator, or NULL. */
+	struct aave_reverb_conv *conv;
+
+	/**
+	 * Convolution reverberator loaded with aave_reverb_conv_set_ir(),
+	 * published atomically and swapped with @p conv by the audio thread
+	 * (see aave_reverb_conv_apply()), or NULL.
+	 */
+	struct aave_reverb_conv *next_conv;
+
+	/**
+	 * List of the convolution reverberators replaced by the audio
+	 * thread, freed by the next aave_reverb_conv_set_ir().
+	 */
+	struct aave_reverb_conv *retired_conv;
+
+	/**
+	 * Engine requested (AAVE_REVERB_* plus 1), stored atomically and
+	 * selected by the audio thread (see aave_reverb_apply()), or 0.
+	 */
+	unsigned next_engine;
+
+	/**
+	 * The late reverberation engine (see aave_reverb_set_engine()):
+	 * runs on a block of input samples and stores the binaural frames
+	 * of the reverberation tail.
+	 */
+	void (*engine)(struct aave_reverb *, const float *, float *, unsigned);
+
+	/**
+	 * Worker thread that runs the reverberator ahead (see
+	 * aave_reverb_thread()), or NULL.
+	 */
+	struct aave_reverb_thread *thread;
 };
 
+/* ambisonics.c */
+extern int aave_ambisonics_decoder(const struct aave *, struct aave_hrtf_lookup *);
+extern void aave_ambisonics_encode(float *, float, float);
+
 /* audio.c */
+extern int aave_alloc_source_buffer(struct aave_source *);
 extern void aave_get_audio(struct aave *, short *, unsigned);
-extern void aave_put_audio(struct aave_source *, const short *, unsigned);
+extern void aave_get_audio_channels(struct aave *, float *, float *, unsigned, unsigned);
+extern void aave_get_audio_f32(struct aave *, float *, unsigned);
+extern int aave_put_audio(struct aave_source *, const short *, unsigned);
+extern int aave_put_audio_f32(struct aave_source *, const float *, unsigned);
+extern void aave_set_render(struct aave *, unsigned, unsigned);
+extern void aave_spectrum_load(float *, const aave_spectrum *, unsigned);
+extern void aave_spectrum_store(aave_spectrum *, const float *, unsigned);
 
 /* dftindex.c */
 extern unsigned dft_index(unsigned, unsigned);
@@ -544,18 +1316,38 @@ extern unsigned dft_index(unsigned, unsigned);
 /* geometry.c */
 extern void aave_add_source(struct aave *, struct aave_source *);
 extern void aave_add_surface(struct aave *, struct aave_surface *);
+extern void aave_get_angles(const float *, float *, float *);
 extern void aave_get_coordinates(const struct aave *, const float *, float *, float *, float *);
+extern void aave_get_directions(struct aave *);
 extern void aave_set_listener_orientation(struct aave *, float, float, float);
 extern void aave_set_listener_position(struct aave *, float, float, float);
+extern void aave_set_source_lod(struct aave_source *, unsigned, unsigned);
 extern void aave_set_source_position(struct aave_source *, float, float, float);
 extern void aave_update(struct aave *);
 
 /* hrtf_cipic.c */
 extern void aave_hrtf_cipic(struct aave *);
 
+/* hrtf_file.c */
+extern void aave_hrtf_close(struct aave *);
+extern float aave_hrtf_delay(const struct aave_hrtf_file *, const float *);
+extern int aave_hrtf_file(struct aave *, const char *);
+extern void aave_hrtf_file_free(struct aave_hrtf_file *);
+extern void aave_hrtf_file_pair(const struct aave_hrtf_file *, const float *[2], int, int);
+
 /* hrtf_listen.c */
 extern void aave_hrtf_listen(struct aave *);
 
+/* hrtf_lookup.c */
+extern void aave_hrtf_lookup(const struct aave *, const float *, const aave_spectrum *[2], float [2]);
+extern void aave_hrtf_lookup_apply(struct aave *);
+extern int aave_hrtf_lookup_decoder(struct aave *);
+extern void aave_hrtf_lookup_free(struct aave *);
+extern int aave_hrtf_lookup_init(struct aave *, void (*)(const struct aave *, const float *[2], int, int), struct aave_hrtf_file *, unsigned);
+
+/* hrtf_minphase.c */
+extern float aave_hrtf_minimum_phase(float *, unsigned, const float *, unsigned);
+
 /* hrtf_mit.c */
 extern void aave_hrtf_mit(struct aave *);
 
@@ -567,24 +1359,63 @@ extern void aave_hrtf_identity(struct aave *);
 
 /* init.c */
 extern void aave_init(struct aave *);
-extern void aave_init_source(struct aave *, struct aave_source *);
+extern int aave_init_source(struct aave *, struct aave_source *);
 
 /* material.c */
 extern const struct aave_material aave_material_none;
 extern const struct aave_material *aave_get_material(const char *);
-extern void aave_get_material_filter(struct aave *, struct aave_surface **, unsigned, float *);
+extern float aave_get_material_gain(struct aave_surface **, unsigned);
+extern unsigned aave_get_material_stride(struct aave_surface **, unsigned);
+extern void aave_get_material_filter(struct aave *, struct aave_surface **, unsigned, aave_spectrum *);
 
 /* obj.c */
 extern void aave_read_obj(struct aave *, const char *);
 
+/* quality.c */
+extern void aave_quality(struct aave *, float);
+extern void aave_quality_account(struct aave *, double, unsigned);
+extern void aave_quality_apply(struct aave *);
+extern double aave_quality_clock(void);
+
+/* reverb.c */
+extern void aave_reverb(struct aave *, float *[2], unsigned, unsigned, unsigned, float);
+extern void aave_reverb_ahead(struct aave *, unsigned);
+extern void aave_reverb_apply(struct aave_reverb *);
+extern void aave_reverb_sync(struct aave *);
+extern int aave_reverb_set_engine(struct aave *, unsigned);
+extern int aave_reverb_thread(struct aave *, int);
+
+/* reverb_conv.c */
+extern void aave_reverb_conv(struct aave_reverb *, const float *, float *, unsigned);
+extern void aave_reverb_conv_apply(struct aave_reverb *);
+extern int aave_reverb_conv_init(struct aave *);
+extern int aave_reverb_conv_set_ir(struct aave *, const float *, const float *, unsigned);
+
 /* reverb_dattorro.c */
-extern void aave_reverb_dattorro(struct aave *, short *, unsigned);
+extern void aave_reverb_dattorro(struct aave_reverb *, const float *, float *, unsigned);
 
 /* reverb_jot.c */
-extern void aave_reverb_jot(struct aave *, short *, unsigned);
+extern void aave_reverb_apply_order(struct aave_reverb *);
+extern void aave_reverb_jot(struct aave_reverb *, const float *, float *, unsigned);
 extern void aave_reverb_init(struct aave *);
+extern void aave_reverb_set_order(struct aave *, unsigned);
 extern void aave_reverb_set_rt60(struct aave *, unsigned short );
 extern void aave_reverb_set_area(struct aave *, unsigned short );
 extern void aave_reverb_set_volume(struct aave *, unsigned short );
 extern void aave_reverb_print_parameters(struct aave*, struct aave_reverb *);
 
+/* source.c */
+extern void aave_advance_sources(struct aave *, unsigned);
+extern void aave_close_source_file(struct aave_source *);
+extern int aave_pcm_data(const unsigned char *, unsigned long, unsigned long *, unsigned long *);
+extern int aave_set_source_file(struct aave_source *, const char *, int);
+extern void aave_set_source_samples(struct aave_source *, const short *, unsigned, int);
+extern float aave_source_sample(const struct aave_source *, unsigned);
+extern void aave_source_window(const struct aave_source *, float *, unsigned, unsigned);
+
+/* stream.c */
+extern void aave_close_source_stream(struct aave_source *);
+extern unsigned aave_get_source_underruns(const struct aave_source *);
+extern void aave_read_stream(struct aave_source *, unsigned);
+extern int aave_set_source_stream(struct aave_source *, const char *, int);
+
@@ -0,0 +1,174 @@
+/*   This file is part of LibAAVE.
+ * 
+ *   LibAAVE is free software: you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation, either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   LibAAVE is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with LibAAVE.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *   Copyright 2014 André Oliveira, Nuno Silva, Guilherme Campos,
+ *   Paulo Dias, José Vieira/IEETA - Universidade de Aveiro
+ *
+ *
+ *   libaave/ambisonics.c: Ambisonics encoding and binaural decoding
+ */
+
+/**
+ * @file ambisonics.c
+ *
+ * The ambisonics.c file implements the AAVE_RENDER_AMBISONICS mode,
+ * selected with aave_set_render(), where the sounds are not multiplied by
+ * their own HRTF pair, but encoded into an Ambisonics bus of order
+ * AAVE_AMBISONICS_ORDER, which is then decoded to binaural once per block.
+ *
+ * Each sound is encoded with one real gain per Ambisonics channel,
+ * the real spherical harmonics (ACN channel order, N3D normalisation)
+ * of its direction of arrival, calculated in aave_ambisonics_encode().
+ * The encoding is performed in the frequency domain, like the rest of
+ * the sound processing in audio.c.
+ *
+ * The binaural decoder is a pair of filters per Ambisonics channel,
+ * calculated in aave_ambisonics_decoder(), with the direction lookup table
+ * of each HRTF set, off the audio thread, from the HRTF pairs of
+ * AAVE_AMBISONICS_SPEAKERS virtual loudspeakers spread evenly over the
+ * sphere, with the max-rE weights of the order in use (sampling decoder).
+ * The processing time of the HRTFs is then constant, independent of the
+ * number of sounds.
+ *
+ * References:
+ * J. Daniel, "Représentation de champs acoustiques, application à la
+ * transmission et à la reproduction de scènes sonores complexes dans un
+ * contexte multimédia", PhD thesis, Université Paris 6, 2000.
+ * M. Noisternig, T. Musil, A. Sontacchi and R. Höldrich, "3D binaural
+ * sound reproduction using a virtual Ambisonic approach", Proc. of the
+ * 2003 IEEE Int. Symposium on Virtual Environments, Human-Computer
+ * Interfaces and Measurement Systems (VECIMS 2003).
+ */
+
+#include <math.h> /* M_PI, asin(), cos(), fmod(), sin(), sqrt() */
+#include <stdlib.h> /* calloc() */
+#include "aave.h"
+
+/**
+ * Number of virtual loudspeakers of the binaural decoder. Must be well
+ * above AAVE_AMBISONICS_CHANNELS for the loudspeakers to sample the
+ * spherical harmonics evenly.
+ */
+#define AAVE_AMBISONICS_SPEAKERS 64
+
+/** Golden angle (rad), to spread the virtual loudspeakers evenly. */
+#define AAVE_AMBISONICS_GOLDEN_ANGLE 2.39996323
+
+/**
+ * The max-rE weights of each order (degree) of the spherical harmonics,
+ * for each Ambisonics order.
+ */
+static const float aave_ambisonics_weights[4][4] = {
+	{ 1 },
+	{ 1, 0.577 },
+	{ 1, 0.775, 0.400 },
+	{ 1, 0.861, 0.612, 0.305 },
+};
+
+/**
+ * Calculate the AAVE_AMBISONICS_CHANNELS encoding gains @p y of a sound
+ * arriving from @p elevation and @p azimuth (rad): the real spherical
+ * harmonics up to order AAVE_AMBISONICS_ORDER, in ACN channel order and
+ * with N3D normalisation.
+ */
+void aave_ambisonics_encode(float *y, float elevation, float azimuth)
+{
+	float x, v, z;
+
+	x = cos(elevation) * cos(azimuth);
+	v = cos(elevation) * sin(azimuth);
+	z = sin(elevation);
+
+	y[0] = 1;
+#if AAVE_AMBISONICS_ORDER >= 1
+	y[1] = sqrt(3) * v;
+	y[2] = sqrt(3) * z;
+	y[3] = sqrt(3) * x;
+#endif
+#if AAVE_AMBISONICS_ORDER >= 2
+	y[4] = sqrt(15) * x * v;
+	y[5] = sqrt(15) * v * z;
+	y[6] = sqrt(5) / 2 * (3 * z * z - 1);
+	y[7] = sqrt(15) * x * z;
+	y[8] = sqrt(15) / 2 * (x * x - v * v);
+#endif
+#if AAVE_AMBISONICS_ORDER >= 3
+	y[9] = sqrt(35. / 8) * v * (3 * x * x - v * v);
+	y[10] = sqrt(105) * x * v * z;
+	y[11] = sqrt(21. / 8) * v * (5 * z * z - 1);
+	y[12] = sqrt(7) / 2 * z * (5 * z * z - 3);
+	y[13] = sqrt(21. / 8) * x * (5 * z * z - 1);
+	y[14] = sqrt(105) / 2 * z * (x * x - v * v);
+	y[15] = sqrt(35. / 8) * x * (x * x - 3 * v * v);
+#endif
+}
+
+/**
+ * Calculate the binaural decoder of the Ambisonics bus of the auralisation
+ * world @p aave for the HRTF set of the direction lookup table @p lookup,
+ * which the audio thread may already use: the decoder is only stored in
+ * @p lookup once it is complete. This is called when the set is selected,
+ * or when the Ambisonics mode is first selected (see hrtf_lookup.c).
+ *
+ * The filter pair of each channel k is the sum of the HRTF pairs of the
+ * virtual loudspeakers s, weighted by w(k) Y(k,s) / S, where Y(k,s) is the
+ * encoding gain of channel k in the direction of loudspeaker s, w(k) is
+ * the max-rE weight of channel k and S is the number of loudspeakers.
+ * Returns 0 on success, or -1 if out of memory.
+ */
+int aave_ambisonics_decoder(const struct aave *aave,
+					struct aave_hrtf_lookup *lookup)
+{
+	float (*decoder)[2][AAVE_MAX_HRTF * 4];
+	float y[AAVE_AMBISONICS_CHANNELS];
+	float elevation, azimuth, w;
+	const float *hrtf[2];
+	unsigned i, j, k, l, c, n;
+
+	decoder = calloc(AAVE_AMBISONICS_CHANNELS, sizeof *decoder);
+	if (!decoder)
+		return -1;
+
+	n = lookup->hrtf_frames * 4;
+
+	for (i = 0; i < AAVE_AMBISONICS_SPEAKERS; i++) {
+		/* Direction of the virtual loudspeaker (Fibonacci sphere). */
+		elevation = asin(1 - (2 * i + 1.)
+					/ AAVE_AMBISONICS_SPEAKERS);
+		azimuth = fmod(i * AAVE_AMBISONICS_GOLDEN_ANGLE, 2 * M_PI)
+									- M_PI;
+
+		if (lookup->hrtf_file)
+			aave_hrtf_file_pair(lookup->hrtf_file, hrtf,
+				elevation * (180/M_PI), azimuth * (180/M_PI));
+		else
+			lookup->hrtf_get(aave, hrtf, elevation * (180/M_PI),
+						azimuth * (180/M_PI));
+		aave_ambisonics_encode(y, elevation, azimuth);
+
+		for (k = 0, l = 0; k < AAVE_AMBISONICS_CHANNELS; k++) {
+			if (k == (l + 1) * (l + 1))
+				l++;
+			w = aave_ambisonics_weights[AAVE_AMBISONICS_ORDER][l]
+				* y[k] / AAVE_AMBISONICS_SPEAKERS;
+			for (c = 0; c < 2; c++)
+				for (j = 0; j < n; j++)
+					decoder[k][c][j] += w * hrtf[c][j];
+		}
+	}
+
+	__atomic_store_n(&lookup->decoder, decoder, __ATOMIC_RELEASE);
+	return 0;
+}
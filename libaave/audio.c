@@ -34,7 +34,9 @@
  * The user passes the anechoic audio data of each sound source in the
  * auralisation world to the library using aave_put_audio() and then
  * retrieves the calculated auralisation binaural audio data using
- * aave_get_audio().
+ * aave_get_audio(). The audio data may also be passed and retrieved as
+ * float samples, using aave_put_audio_f32() and aave_get_audio_f32(),
+ * which the library processes internally without conversion or clipping.
  *
  * Although the library supports processing one audio frame at a time,
  * users would typically work with blocks of audio frames at a time,
@@ -129,6 +131,9 @@
  * in the frequency domain, taking advantage that they can be applied at the
  * same time the HRTF filter is, simply by multiplying the magnitude of the
  * frequency response by the appropriate combined gain value, in cmadd().
+ * The same fade-out is used to drop the quietest sounds when there are more
+ * sounds than the render budget aave->max_sounds allows, so that the
+ * processing time stays bounded (see aave_hrtf_cull_sounds()).
  *
  * The result of each sound processing block is therefore 3 binaural audio
  * signals (6 total), still in the frequency domain: DFT bus 0 with the
@@ -137,23 +142,41 @@
  * the current parametres, and DFT bus 2 with the current block processed
  * with the current parametres.
  *
+ * Many sounds, mostly high order reflections, arrive from nearly the same
+ * direction, and therefore resolve to the same HRTF pair. In the
+ * AAVE_RENDER_CLUSTER mode, selected with aave_set_render(), the sounds
+ * of each HRTF pair are summed first, in madd(), and each sum is then
+ * multiplied by the HRTF pair only once per block. The processing time
+ * then depends on the number of distinct directions, more than on the
+ * number of sounds. The AAVE_RENDER_COARSE mode rounds the directions
+ * to a coarse grid first, for the late reflections, which the ear does not
+ * localise precisely. In the AAVE_RENDER_AMBISONICS mode, the sounds are
+ * instead encoded into an Ambisonics bus with a few real gains, and the
+ * bus is decoded to binaural with a fixed number of HRTF filters
+ * (see ambisonics.c).
+ *
  * The binaural audio signals now need to be converted back to the time
  * domain. But instead of performing 6 inverse discrete Fourier transforms
  * (IDFT) per sound and then summing them in the time domain, the different
  * sounds are summed still in the frequency domain, into the DFT busses
- * pictured. This way, only 6 IDFT are performed in total, independently
- * of the number of sounds.
+ * pictured. This way, only a fixed number of IDFT are performed in total,
+ * independently of the number of sounds.
  *
- * To complete the fast convolution method, the sounds in the 6 busses,
- * now in the time domain, are overlap-added, as described in:
- * Udo Zolzer, "Digital Audio Signal Processing", 2nd Edition,
- * Section 5.3.2 Fast Convolution of Long Sequences.
- * @todo Here, it might be more efficient to use the overlap-save method
- * instead of the overlap-add method.
+ * To complete the fast convolution method, the overlap-save method is used,
+ * as described in: Udo Zolzer, "Digital Audio Signal Processing",
+ * 2nd Edition, Section 5.3.2 Fast Convolution of Long Sequences.
+ * Still in the frequency domain, each DFT bus of the previous parametres
+ * is combined with the DFT bus of the previous block, and each DFT bus of
+ * the current parametres with the DFT bus of the current block, delayed
+ * by one block (a delay of half the DFT size simply negates the odd
+ * frequencies). Only 2 IDFT per channel are then needed, and only the
+ * second half of their output, the one without circular convolution
+ * artifacts, is calculated.
  *
  * Linear fade-outs and fade-ins are then applied to the previous and
- * current parametre busses, respectively, to complete the crossfade
- * method described in Tom Barker et al (see above).
+ * current parametre signals, respectively, to complete the crossfade
+ * method described in Tom Barker et al (see above), together with the
+ * last pass of the IDFT, in aave_hrtf_output().
  *
  * At this point, the left and right signals contain the binaural
  * auralisation of the direct sounds and reflection sounds up to
@@ -162,17 +185,20 @@
  * reflections that the geometry.c part could not calculate.
  */
 
-#include <math.h> /* M_PI */
+#include <math.h> /* M_PI, fabs(), floor(), log10(), sqrt() */
+#include <stdlib.h> /* calloc(), malloc() */
 #include <string.h> /* memcpy() */
 #include <stdio.h>
 #include "aave.h"
 
-/** Create a dft() function to convert 16-bit audio samples to frequency. */
-#define DFT_TYPE short
+/** Create a dft() function to convert audio samples to frequency. */
+#define DFT_TYPE float
 #include "dft.h"
 
-/** Create an idft() function to convert frequency to 32-bit audio samples. */
-#define IDFT_TYPE int
+/**
+ * Create an idft_passes() function to convert frequency to audio samples,
+ * all but the last pass, which is performed in aave_hrtf_output().
+ */
 #include "idft.h"
 
 /**
@@ -201,9 +227,34 @@
  * b1 = exp(-1/d) = exp(-1/4410) ~= 0.99977
  *
  * Reference: The Scientist and Engineer's Guide to DSP, chapter 19.
+ *
+ * The filter output for a constant input x is calculated in closed form,
+ * with the table aave_distance_decay generated by tools/distance.c
+ * (regenerate it when changing this value):
+ *
+ * y[n+i] = x + (y[n-1] - x) * b1^(i+1)
  */
 #define AAVE_DISTANCE_B1 0.99977
 
+/** Table of b1^(i+1), generated by tools/distance.c. */
+extern const float aave_distance_decay[];
+
+/**
+ * Fraction of a sample below which the resampler considers the delay
+ * constant, and below which it does not interpolate.
+ */
+#define AAVE_RESAMPLE_TOLERANCE (1. / 256)
+
+/**
+ * Number of level classes used to rank the sounds for the render budget
+ * (see aave_hrtf_cull_sounds()), each AAVE_CULL_STEP dB wide.
+ * Sounds below the lowest class are ranked in the lowest class.
+ */
+#define AAVE_CULL_CLASSES 64
+
+/** Width of each level class used to rank the sounds (dB). */
+#define AAVE_CULL_STEP 1.5
+
 /**
  * Return the gain corresponding to the amplitude attenuation
  * of a sound at the specified @p distance (m).
@@ -232,7 +283,114 @@ static float fade_out_gain(unsigned i, unsigned frames)
 }
 
 /**
- * Calculate the Complex MULtiplication @p a = @p a * @p b of size @p n.
+ * Return the level class, from 0 (loudest) to AAVE_CULL_CLASSES - 1,
+ * of a sound with the estimated @p level (gain).
+ */
+static unsigned cull_class(float level)
+{
+	float k;
+
+	if (level >= 1)
+		return 0;
+	if (level <= 0)
+		return AAVE_CULL_CLASSES - 1;
+
+	k = -20 * log10(level) / AAVE_CULL_STEP;
+	if (k >= AAVE_CULL_CLASSES - 1)
+		return AAVE_CULL_CLASSES - 1;
+
+	return k;
+}
+
+#ifdef AAVE_BF16
+/** Return the float value of the bfloat16 @p x (see aave_spectrum). */
+static float bf16_float(aave_spectrum x)
+{
+	union { float f; unsigned u; } v;
+
+	v.u = (unsigned)x << 16;
+	return v.f;
+}
+
+/**
+ * Return the bfloat16 value of the float @p x (see aave_spectrum),
+ * rounded to the nearest, ties to even.
+ */
+static aave_spectrum float_bf16(float x)
+{
+	union { float f; unsigned u; } v;
+
+	v.f = x;
+	v.u += 0x7fff + ((v.u >> 16) & 1);
+	return v.u >> 16;
+}
+#else
+#define bf16_float(x) (x)
+#endif
+
+/**
+ * Convert the spectrum @p x of size @p n from its storage type
+ * (see aave_spectrum) to the floats @p y.
+ */
+void aave_spectrum_load(float *y, const aave_spectrum *x, unsigned n)
+{
+#ifdef AAVE_BF16
+	unsigned i;
+
+	for (i = 0; i < n; i++)
+		y[i] = bf16_float(x[i]);
+#else
+	if (y != x)
+		memcpy(y, x, n * sizeof(y[0]));
+#endif
+}
+
+/**
+ * Convert the spectrum @p x of @p n floats to its storage type
+ * (see aave_spectrum) in @p y.
+ */
+void aave_spectrum_store(aave_spectrum *y, const float *x, unsigned n)
+{
+#ifdef AAVE_BF16
+	unsigned i;
+
+	for (i = 0; i < n; i++)
+		y[i] = float_bf16(x[i]);
+#else
+	if (y != x)
+		memcpy(y, x, n * sizeof(y[0]));
+#endif
+}
+
+/**
+ * Return a float buffer to calculate the spectrum @p x in, before it is
+ * stored with aave_spectrum_store(): @p x itself, if the spectra are stored
+ * as floats, or @p y otherwise.
+ */
+static float *spectrum_buffer(aave_spectrum *x, float *y)
+{
+#ifdef AAVE_BF16
+	(void)x;
+	return y;
+#else
+	(void)y;
+	return x;
+#endif
+}
+
+/*
+ * Band-limited processing: the Fourier coefficients calculated by dft() are
+ * stored in bit-reversed order (see dft_index()), so that the coefficients
+ * of the lowest 1 / s of the band, for s a power of 2, are the ones stored
+ * at the complex positions multiple of s. The functions below process only
+ * these, when the material absorption filter of a sound is negligible above
+ * that band (see aave_get_material_stride()). The coefficients skipped
+ * are simply not added to the DFT busses, which are zeroed every block.
+ */
+
+/**
+ * Calculate the Complex MULtiplication @p a = @p a * @p b of size @p n,
+ * of the lowest 1 / @p s of the band (see aave_get_material_stride()).
  *
  * A = A * B
  *
@@ -240,19 +398,20 @@ static float fade_out_gain(unsigned i, unsigned frames)
  *
  * A = (ar * br - ai * bi) + j (ar * bi + ai * br)
  */
-static void cmul(float *a, const float *b, unsigned n)
+static void cmul(float *a, const aave_spectrum *b, unsigned n, unsigned s)
 {
 	float ar, ai, br, bi;
 	unsigned i;
 
-	a[0] = a[0] * b[0]; /* A[0] */
-	a[1] = a[1] * b[1]; /* A[N/2] */
+	a[0] = a[0] * bf16_float(b[0]); /* A[0] */
+	if (s == 1)
+		a[1] = a[1] * bf16_float(b[1]); /* A[N/2] */
 
-	for (i = 2; i < n; i += 2) {
+	for (i = 2 * s; i < n; i += 2 * s) {
 		ar = a[i];
 		ai = a[i+1];
-		br = b[i];
-		bi = b[i+1];
+		br = bf16_float(b[i]);
+		bi = bf16_float(b[i+1]);
 		a[i] = ar * br - ai * bi;
 		a[i+1] = ar * bi + ai * br;
 	}
@@ -260,7 +419,8 @@ static void cmul(float *a, const float *b, unsigned n)
 
 /**
  * Calculate the Complex Multiplication and ADDition
- * @p y += @p g * @p a * @p b of size @p n.
+ * @p y += @p g * @p a * @p b of size @p n,
+ * of the lowest 1 / @p s of the band (see aave_get_material_stride()).
  *
  * Y += g * A * B
  *
@@ -268,15 +428,17 @@ static void cmul(float *a, const float *b, unsigned n)
  *
  * Y += g * (ar * br - ai * bi) + j g * (ar * bi + ai * br)
  */
-static void cmadd(float *y, const float *a, const float *b, unsigned n, float g)
+static void cmadd(float *y, const float *a, const float *b, unsigned n,
+							unsigned s, float g)
 {
 	float ar, ai, br, bi;
 	unsigned i;
 
 	y[0] += g * a[0] * b[0]; /* A[0] */
-	y[1] += g * a[1] * b[1]; /* A[N/2] */
+	if (s == 1)
+		y[1] += g * a[1] * b[1]; /* A[N/2] */
 
-	for (i = 2; i < n; i += 2) {
+	for (i = 2 * s; i < n; i += 2 * s) {
 		ar = a[i];
 		ai = a[i+1];
 		br = b[i];
@@ -286,9 +448,222 @@ static void cmadd(float *y, const float *a, const float *b, unsigned n, float g)
 	}
 }
 
+#ifdef AAVE_BF16
+/**
+ * Calculate @p y += @p g * @p a * @p b as cmadd() does, for the spectrum
+ * @p b in its storage type (see aave_spectrum).
+ */
+static void cmadd_spectrum(float *y, const float *a, const aave_spectrum *b,
+					unsigned n, unsigned s, float g)
+{
+	float ar, ai, br, bi;
+	unsigned i;
+
+	y[0] += g * a[0] * bf16_float(b[0]); /* A[0] */
+	if (s == 1)
+		y[1] += g * a[1] * bf16_float(b[1]); /* A[N/2] */
+
+	for (i = 2 * s; i < n; i += 2 * s) {
+		ar = a[i];
+		ai = a[i+1];
+		br = bf16_float(b[i]);
+		bi = bf16_float(b[i+1]);
+		y[i] += g * (ar * br - ai * bi);
+		y[i+1] += g * (ar * bi + ai * br);
+	}
+}
+#else
+#define cmadd_spectrum cmadd
+#endif
+
+/**
+ * Calculate the Multiplication and ADDition
+ * @p y += @p g * @p a of size @p n,
+ * of the lowest 1 / @p s of the band (see aave_get_material_stride()).
+ */
+static void madd(float *y, const float *a, unsigned n, unsigned s, float g)
+{
+	unsigned i;
+
+	if (s == 1) {
+		for (i = 0; i < n; i++)
+			y[i] += g * a[i];
+		return;
+	}
+
+	y[0] += g * a[0]; /* A[0] */
+
+	for (i = 2 * s; i < n; i += 2 * s) {
+		y[i] += g * a[i];
+		y[i+1] += g * a[i+1];
+	}
+}
+
+/**
+ * Return the direction cluster of the HRTF pair @p hrtf and DFT bus @p bus
+ * in the auralisation world @p aave, creating it for DFT of size @p n if it
+ * is not in use yet, or 0 if there are no more clusters available.
+ */
+static struct aave_cluster *aave_cluster(struct aave *aave,
+			const aave_spectrum *hrtf[2], unsigned bus, unsigned n)
+{
+	struct aave_cluster *cluster;
+	unsigned h, i;
+
+	/* Look up the cluster in the hash table (linear probing). */
+	h = ((unsigned long)hrtf[0] / sizeof(aave_spectrum)
+		^ (unsigned long)hrtf[1] / sizeof(aave_spectrum) * 3 ^ bus * 7)
+		% (AAVE_MAX_CLUSTERS * 2);
+	while ((i = aave->cluster_hash[h])) {
+		cluster = &aave->clusters[i - 1];
+		if (cluster->hrtf[0] == hrtf[0] && cluster->hrtf[1] == hrtf[1]
+						&& cluster->bus == bus)
+			return cluster;
+		h = (h + 1) % (AAVE_MAX_CLUSTERS * 2);
+	}
+
+	if (aave->nclusters == AAVE_MAX_CLUSTERS)
+		return 0;
+
+	/* Create a new cluster. */
+	cluster = &aave->clusters[aave->nclusters++];
+	cluster->hrtf[0] = hrtf[0];
+	cluster->hrtf[1] = hrtf[1];
+	cluster->bus = bus;
+	cluster->ears = 0;
+	memset(cluster->dft, 0, n * sizeof(cluster->dft[0]));
+	aave->cluster_hash[h] = aave->nclusters;
+
+	return cluster;
+}
+
+/**
+ * Add the DFT @p x of size @p n of a sound, with gain @p g and HRTF pair
+ * @p hrtf, to the DFT bus @p bus of the DFT busses @p ydft, according to
+ * the rendering mode @p render, and of the lowest 1 / @p s of the band.
+ * @p x[0] is the DFT for the left ear, @p x[1] for the right ear, which
+ * are the same unless the HRTF set has delays (see aave_hrtf_add_sound()).
+ */
+static void aave_hrtf_bus_add(struct aave *aave,
+			float ydft[3][2][AAVE_MAX_HRTF * 4], unsigned bus,
+			const float *x[2], const aave_spectrum *hrtf[2], unsigned n,
+			unsigned s, float g, unsigned render)
+{
+	struct aave_cluster *cluster;
+	unsigned c;
+
+	if ((render == AAVE_RENDER_CLUSTER || render == AAVE_RENDER_COARSE)
+	    && (cluster = aave_cluster(aave, hrtf, bus, n))) {
+		if (x[1] != x[0] && !cluster->ears) {
+			memcpy(cluster->dft_right, cluster->dft,
+						n * sizeof(cluster->dft[0]));
+			cluster->ears = 1;
+		}
+		madd(cluster->dft, x[0], n, s, g);
+		if (cluster->ears)
+			madd(cluster->dft_right, x[1], n, s, g);
+		return;
+	}
+
+	for (c = 0; c < 2; c++)
+		cmadd_spectrum(ydft[bus][c], x[c], hrtf[c], n, s, g);
+}
+
+/**
+ * Multiply the direction clusters of the auralisation world @p aave
+ * by their HRTF pairs and add them to the DFT busses @p ydft of size @p n.
+ */
+static void aave_hrtf_clusters_add(struct aave *aave,
+			float ydft[3][2][AAVE_MAX_HRTF * 4], unsigned n)
+{
+	struct aave_cluster *cluster;
+	unsigned i, c;
+
+	for (i = 0; i < aave->nclusters; i++) {
+		cluster = &aave->clusters[i];
+		for (c = 0; c < 2; c++)
+			cmadd_spectrum(ydft[cluster->bus][c],
+				c && cluster->ears ? cluster->dft_right
+						: cluster->dft,
+				cluster->hrtf[c], n, 1, 1);
+	}
+
+	aave->nclusters = 0;
+	memset(aave->cluster_hash, 0, sizeof aave->cluster_hash);
+}
+
+/**
+ * Add a sound to the Ambisonics bus of the auralisation world @p aave.
+ * @p z is the DFT of size @p n of the previous audio block of the
+ * @p sound, @p x of the current one, @p gain and @p gain_prev are the
+ * current and previous gain
+ * parameters, and @p elevation and @p azimuth the current direction.
+ *
+ * Since the Ambisonics encoding gains are scalars, the previous and current
+ * audio blocks are added to the bus one after the other in time, as in
+ * the overlap-save method, and the 3 DFT busses reduce to 2: previous and
+ * current parameters. Delaying the current block by n / 2 samples
+ * negates its odd frequencies, the upper half of the DFT (see dft.h).
+ */
+static void aave_ambisonics_add_sound(struct aave *aave,
+			struct aave_sound *sound, float *z, const float *x,
+			unsigned n,
+			float gain, float gain_prev,
+			float elevation, float azimuth)
+{
+	struct aave_ambisonics *ambisonics = aave->ambisonics;
+	float y[AAVE_AMBISONICS_CHANNELS];
+	unsigned i, k;
+
+	for (i = 0; i < n / 2; i++)
+		z[i] += x[i];
+	for (; i < n; i++)
+		z[i] -= x[i];
+
+	aave_ambisonics_encode(y, elevation, azimuth);
+
+	for (k = 0; k < AAVE_AMBISONICS_CHANNELS; k++) {
+		madd(ambisonics->bus[0][k], z, n, sound->stride,
+					gain_prev * sound->ambisonics[k]);
+		madd(ambisonics->bus[1][k], z, n, sound->stride,
+							gain * y[k]);
+	}
+
+	memcpy(sound->ambisonics, y, sizeof y);
+	ambisonics->active = 1;
+}
+
+/**
+ * Decode the Ambisonics bus of the auralisation world @p aave to the
+ * channel @p c, and add it to the previous (@p a) and current (@p b)
+ * parameters DFT of @p frames frames of the output stage.
+ */
+static void aave_ambisonics_decode(struct aave *aave, float *a, float *b,
+						unsigned c, unsigned frames)
+{
+	struct aave_ambisonics *ambisonics = aave->ambisonics;
+	float (*decoder)[2][AAVE_MAX_HRTF * 4];
+	unsigned k;
+
+	/* The decoder of the set, none until aave_set_render() is done. */
+	decoder = __atomic_load_n(&aave->hrtf_lookup->decoder,
+							__ATOMIC_ACQUIRE);
+	if (!decoder)
+		return;
+
+	for (k = 0; k < AAVE_AMBISONICS_CHANNELS; k++) {
+		cmadd(a, ambisonics->bus[0][k], decoder[k][c],
+							frames * 2, 1, 1);
+		cmadd(b, ambisonics->bus[1][k], decoder[k][c],
+							frames * 2, 1, 1);
+	}
+}
+
 /**
  * Generate one audio source block.
  * @p sound is the sound whose source to get the anechoic audio data from,
+ * @p smooth is its smooth distance to update (sound->distance_smooth, or
+ * sound->distance_smooth_right for the right ear, see aave_hrtf_add_sound()),
  * @p distance is the distance from the (image) source to the listener,
  * @p x is the buffer to store the generated audio data,
  * @p frames is the number of frames (anechoic samples) to generate, and
@@ -303,26 +678,140 @@ static void cmadd(float *y, const float *a, const float *b, unsigned n, float g)
  * pass filtered version of the discontinuous distance value, as described in
  * Peter Brinkman and Michael Gogins, "Doppler effects without equations",
  * Proc. of the 16th Int. Conf. on Digital Audio Effects (DAFx-13).
+ *
+ * The low-pass filtered distance is calculated in closed form for the
+ * whole block, so that the interpolation loop has no dependencies between
+ * samples. When the delay is constant to within AAVE_RESAMPLE_TOLERANCE
+ * samples, as for most sounds in a static scene, the ring buffer is read
+ * in sequence, and simply copied if no interpolation is needed.
+ *
+ * The sources whose samples are read from memory (see source.c) have no
+ * ring buffer: the samples the block reads, between its largest and its
+ * smallest delay, are first gathered in a window with aave_source_window(),
+ * which the interpolation loop then reads as it reads the ring buffer.
  */
-static void aave_audio_source_block(struct aave_sound *sound, float distance,
-				short *x, unsigned frames, unsigned delay)
+static void aave_audio_source_block(struct aave_sound *sound, float *smooth,
+		float distance, float *x, unsigned frames, unsigned delay)
 {
-	unsigned d, i, j;
-	short x1, x2;
-	float f, a;
+	const struct aave_source *source = sound->source;
+	const float *buffer = source->samples ? 0 : source->buffer;
+	unsigned d, i, j, k, n, base = 0, mask = AAVE_SOURCE_BUFSIZE - 1;
+	float x1, x2;
+	float e, a, b[AAVE_MAX_HRTF * 2], w[AAVE_MAX_HRTF * 4];
+
+	d = source->buffer_index - frames - delay;
 
-	d = sound->source->buffer_index - frames - delay;
-	f = sound->distance_smooth;
-	for (i = 0; i < frames; i++) {
-		f = AAVE_DISTANCE_B1 * f + (1 - AAVE_DISTANCE_B1) * distance;
-		a = f * (AAVE_FS / AAVE_SOUND_SPEED);
-		j = d++ - (unsigned)a;
+	/* Distance to go, scaled to samples. */
+	e = (*smooth - distance) * (AAVE_FS / AAVE_SOUND_SPEED);
+
+	if (fabs(e) < AAVE_RESAMPLE_TOLERANCE) {
+		/* Constant delay: the ring buffer is read in sequence. */
+		a = distance * (AAVE_FS / AAVE_SOUND_SPEED);
+		j = d - (unsigned)a;
 		a = a - (unsigned)a;
-		x1 = sound->source->buffer[j & (AAVE_SOURCE_BUFSIZE - 1)];
-		x2 = sound->source->buffer[(j-1) & (AAVE_SOURCE_BUFSIZE - 1)];
-		x[i] = x1 * (1 - a) + x2 * a;
+		if (a < AAVE_RESAMPLE_TOLERANCE && !buffer) {
+			aave_source_window(source, x, j, frames);
+		} else if (a < AAVE_RESAMPLE_TOLERANCE) {
+			/* Copy, in up to 2 parts, due to the wrap-around. */
+			j &= AAVE_SOURCE_BUFSIZE - 1;
+			k = AAVE_SOURCE_BUFSIZE - j;
+			if (k > frames)
+				k = frames;
+			memcpy(x, buffer + j, k * sizeof(x[0]));
+			memcpy(x + k, buffer, (frames - k) * sizeof(x[0]));
+		} else {
+			if (!buffer) {
+				base = j - 1;
+				mask = -1;
+				buffer = w;
+				aave_source_window(source, w, base, frames + 1);
+			}
+			for (i = 0; i < frames; i++, j++) {
+				x1 = buffer[(j - base) & mask];
+				x2 = buffer[(j - 1 - base) & mask];
+				x[i] = x1 * (1 - a) + x2 * a;
+			}
+		}
+		*smooth = distance;
+		return;
 	}
-	sound->distance_smooth = f;
+
+	/* Delays, in samples, of the smooth distance trajectory. */
+	a = distance * (AAVE_FS / AAVE_SOUND_SPEED);
+	for (i = 0; i < frames; i++)
+		b[i] = a + e * aave_distance_decay[i];
+
+	if (!buffer) {
+		/* The delays are monotonic: the window spans the extreme ones. */
+		k = b[0] < b[frames - 1] ? frames - 1 : 0;
+		n = frames + (unsigned)b[k] - (unsigned)b[frames - 1 - k] + 1;
+		if (n <= sizeof(w) / sizeof(w[0])) {
+			base = d - (unsigned)b[k] - 1;
+			mask = -1;
+			buffer = w;
+			aave_source_window(source, w, base, n);
+		}
+	}
+
+	if (buffer) {
+		for (i = 0; i < frames; i++) {
+			a = b[i];
+			j = d++ - (unsigned)a;
+			a = a - (unsigned)a;
+			x1 = buffer[(j - base) & mask];
+			x2 = buffer[(j - 1 - base) & mask];
+			x[i] = x1 * (1 - a) + x2 * a;
+		}
+	} else {
+		/* A jump of the delay too large for the window. */
+		for (i = 0; i < frames; i++) {
+			a = b[i];
+			j = d++ - (unsigned)a;
+			a = a - (unsigned)a;
+			x1 = aave_source_sample(source, j);
+			x2 = aave_source_sample(source, j - 1);
+			x[i] = x1 * (1 - a) + x2 * a;
+		}
+	}
+	*smooth = distance + (*smooth - distance)
+				* aave_distance_decay[frames - 1];
+}
+
+/**
+ * Return 1 if the samples of the source of a @p sound that the next block
+ * of @p frames frames is generated from, at the distances @p ear of the
+ * left and right ears and with @p delay frames of pre-delay, are all
+ * silent, or 0 otherwise.
+ */
+static int aave_audio_source_silent(const struct aave_sound *sound,
+			const float ear[2], unsigned frames, unsigned delay)
+{
+	float a;
+
+	/* The smooth distances vary between the previous and current. */
+	a = ear[0] > ear[1] ? ear[0] : ear[1];
+	if (sound->distance_smooth > a)
+		a = sound->distance_smooth;
+	if (sound->distance_smooth_right > a)
+		a = sound->distance_smooth_right;
+	a = a * (AAVE_FS / AAVE_SOUND_SPEED) + 3;
+
+	return sound->source->silence >= frames + delay + a;
+}
+
+/**
+ * Skip one audio source block of @p frames frames of a silent @p sound,
+ * updating the smooth distances towards the distances @p ear of the left
+ * and right ears as aave_audio_source_block() does, in closed form.
+ */
+static void aave_audio_source_skip(struct aave_sound *sound,
+				const float ear[2], unsigned frames)
+{
+	sound->distance_smooth = ear[0] + (sound->distance_smooth - ear[0])
+					* aave_distance_decay[frames - 1];
+	sound->distance_smooth_right = ear[1]
+			+ (sound->distance_smooth_right - ear[1])
+					* aave_distance_decay[frames - 1];
 }
 
 /**
@@ -330,76 +819,320 @@ static void aave_audio_source_block(struct aave_sound *sound, float distance,
  * @p frames is the number of frames to process.
  * @p delay is the number of frames of pre-delay to apply to the sound
  * to account for audio user blocks larger than the size of the HRTFs.
+ * @p render is the rendering mode of the sound (AAVE_RENDER_*).
+ * Returns 1 if the sound was processed, or 0 if it is inaudible or silent.
+ *
+ * The sounds whose source samples are silent, as well as their previous
+ * block, are not processed: their DFT is zero.
+ *
+ * When the HRTF set has delays (see hrtf_minphase.c), the ears get their
+ * own audio blocks, with the delay of their HRTF added to the distance, so
+ * that the resampler applies it and interpolates it smoothly as the sound
+ * moves, except in the AAVE_RENDER_AMBISONICS mode, where the delays are
+ * left out, since the sounds are encoded to a single bus.
  */
-static void aave_hrtf_add_sound(struct aave *aave, struct aave_sound *sound,
+static int aave_hrtf_add_sound(struct aave *aave, struct aave_sound *sound,
 				float ydft[3][2][AAVE_MAX_HRTF * 4],
-				unsigned delay, unsigned frames)
+				unsigned delay, unsigned frames, unsigned render)
 {
-	unsigned fade_samples, c;
-	float gain, distance, elevation, azimuth;
-	const float *hrtf[2];
-	short x[AAVE_MAX_HRTF * 2];
+	unsigned fade_samples, i;
+	int audible, silent, ears;
+	float gain, gain_prev, distance, elevation, azimuth, ear[2];
+	float v[3], hrtf_delay[2], *u[2];
+	const aave_spectrum *hrtf[2];
+	const float *y[2];
+	float x[AAVE_MAX_HRTF * 2];
+	float z[AAVE_MAX_HRTF * 4];
+	float w[2][AAVE_MAX_HRTF * 4];
+
+	/* Sounds over the render budget fade out as inaudible sounds do. */
+	audible = sound->audible && !sound->culled;
 
 	/* Do nothing if the sound is inaudible and the fade-out is done. */
-	if (!sound->audible && !sound->fade_samples)
-		return;
+	if (!audible && !sound->fade_samples)
+		return 0;
+
+	/* The coordinates for the current positions (aave_get_directions()). */
+	distance = sound->distance_current;
+
+	if (render == AAVE_RENDER_AMBISONICS || render == AAVE_RENDER_COARSE) {
+		/* These modes need the angles of the direction. */
+		aave_get_angles(sound->direction, &elevation, &azimuth);
+
+		/* Round the direction to the coarse grid. */
+		if (render == AAVE_RENDER_COARSE) {
+			elevation = floor(elevation * (180 / M_PI
+				/ AAVE_COARSE_STEP) + 0.5)
+					* (AAVE_COARSE_STEP * M_PI / 180);
+			azimuth = floor(azimuth * (180 / M_PI
+				/ AAVE_COARSE_STEP) + 0.5)
+					* (AAVE_COARSE_STEP * M_PI / 180);
+			v[0] = cos(elevation) * cos(azimuth);
+			v[1] = -cos(elevation) * sin(azimuth);
+			v[2] = -sin(elevation);
+		} else
+			memcpy(v, sound->direction, sizeof v);
+	} else {
+		memcpy(v, sound->direction, sizeof v);
+		elevation = azimuth = 0;
+	}
 
-	/* Calculate the coordinates for the current positions. */
-	aave_get_coordinates(aave, sound->position, &distance, &elevation,
-								&azimuth);
+	/* Get the HRTF pair from the direction lookup table. */
+	aave_hrtf_lookup(aave, v, hrtf, hrtf_delay);
 
-	/* Get the best HRTF pair for these coordinates. */
-	aave->hrtf_get(hrtf, elevation * (180/M_PI), azimuth * (180/M_PI));
+	/* Distances of the ears, with the delays of the HRTF set. */
+	if (render == AAVE_RENDER_AMBISONICS)
+		ear[0] = ear[1] = distance;
+	else
+		for (i = 0; i < 2; i++)
+			ear[i] = distance + hrtf_delay[i]
+					* (AAVE_SOUND_SPEED / AAVE_FS);
 
 	/* Update the fade-in/out sample count. */
 	fade_samples = sound->fade_samples;
-	if (sound->audible) {
+	if (audible) {
 		if (fade_samples < AAVE_FADE_SAMPLES) {
 			if (!fade_samples) {
 				/* Set defaults for the first iteration. */
 				sound->distance = distance;
-				sound->distance_smooth = distance;
+				sound->distance_smooth = ear[0];
+				sound->distance_smooth_right = ear[1];
+				sound->ears = 0;
 				sound->hrtf[0] = hrtf[0];
 				sound->hrtf[1] = hrtf[1];
+				if (render == AAVE_RENDER_AMBISONICS)
+					aave_ambisonics_encode(
+						sound->ambisonics,
+						elevation, azimuth);
 			}
 			fade_samples += frames;
 		}
 	} else if (fade_samples > 0)
 			fade_samples -= frames;
 
+	/* Skip the sound if this and the previous block are silent. */
+	silent = aave_audio_source_silent(sound, ear, frames, delay);
+	if (silent && sound->silent) {
+		aave_audio_source_skip(sound, ear, frames);
+		sound->ears = 0;
+		if (render == AAVE_RENDER_AMBISONICS)
+			aave_ambisonics_encode(sound->ambisonics,
+							elevation, azimuth);
+		sound->fade_samples = fade_samples;
+		sound->distance = distance;
+		sound->hrtf[0] = hrtf[0];
+		sound->hrtf[1] = hrtf[1];
+		return 0;
+	}
+
 	/* Current gain parameter. */
 	gain = attenuation(distance) * fade_samples / AAVE_FADE_SAMPLES;
 
-	/* DFT bus 1: previous block with current parameters. */
-	for (c = 0; c < 2; c++)
-		cmadd(ydft[1][c], sound->dft, hrtf[c], frames * 2, gain);
+	/* Previous gain parameter. */
+	gain_prev = attenuation(sound->distance) * sound->fade_samples
+							/ AAVE_FADE_SAMPLES;
 
-	/* Generate the current audio block (resampler). */
-	aave_audio_source_block(sound, distance, x, frames, delay);
+	/* DFTs of the previous block of the left and right ears. */
+	u[0] = spectrum_buffer(sound->dft, w[0]);
+	u[1] = sound->ears ? spectrum_buffer(sound->dft_right, w[1]) : w[1];
+	aave_spectrum_load(u[0], sound->dft, frames * 2);
+	if (sound->ears)
+		aave_spectrum_load(u[1], sound->dft_right, frames * 2);
+	y[0] = u[0];
+	y[1] = sound->ears ? u[1] : u[0];
 
-	/* Convert to the frequency domain, zero padded to 2 times. */
-	dft(sound->dft, x, frames * 2);
+	if (render == AAVE_RENDER_AMBISONICS)
+		/* Keep the previous block for the Ambisonics bus. */
+		memcpy(z, y[0], 2 * sizeof(z[0]) * frames);
+	else
+		/* DFT bus 1: previous block with current parameters. */
+		aave_hrtf_bus_add(aave, ydft, 1, y, hrtf, frames * 2,
+						sound->stride, gain, render);
 
-	/* Apply the material absorption filter. */
-	cmul(sound->dft, sound->filter, frames * 2);
+	/* The right ear is only allocated by aave_update(), maybe not yet. */
+	ears = !silent && (ear[0] != ear[1] || sound->distance_smooth
+					!= sound->distance_smooth_right)
+		&& __atomic_load_n(&sound->dft_right, __ATOMIC_ACQUIRE);
+	if (ears && !sound->ears)
+		u[1] = spectrum_buffer(sound->dft_right, w[1]);
 
-	/* DFT bus 2: current block with current parameters. */
-	for (c = 0; c < 2; c++)
-		cmadd(ydft[2][c], sound->dft, hrtf[c], frames * 2, gain);
+	if (silent) {
+		/* The current audio block is silent. */
+		aave_audio_source_skip(sound, ear, frames);
+		memset(u[0], 0, 2 * sizeof(u[0][0]) * frames);
+	} else {
+		/* Generate the current audio block (resampler). */
+		aave_audio_source_block(sound, &sound->distance_smooth, ear[0],
+							x, frames, delay);
 
-	/* Previous gain parameter. */
-	gain = attenuation(sound->distance) * sound->fade_samples
-							/ AAVE_FADE_SAMPLES;
+		/* Convert to the frequency domain, zero padded to 2 times. */
+		dft(u[0], x, frames * 2);
 
-	/* DFT bus 0: current block with previous parameters. */
-	for (c = 0; c < 2; c++)
-		cmadd(ydft[0][c], sound->dft, sound->hrtf[c], frames*2, gain);
+		/* Apply the material absorption filter. */
+		cmul(u[0], sound->filter, frames * 2, sound->stride);
+
+		/* The same for the right ear, if it has its own block. */
+		if (ears) {
+			aave_audio_source_block(sound,
+					&sound->distance_smooth_right, ear[1],
+					x, frames, delay);
+			dft(u[1], x, frames * 2);
+			cmul(u[1], sound->filter, frames * 2, sound->stride);
+		} else
+			sound->distance_smooth_right = sound->distance_smooth;
+	}
+
+	/* Keep the current block for the next one. */
+	aave_spectrum_store(sound->dft, u[0], frames * 2);
+	if (ears)
+		aave_spectrum_store(sound->dft_right, u[1], frames * 2);
+
+	/* DFTs of the current block of the left and right ears. */
+	y[0] = u[0];
+	y[1] = ears ? u[1] : u[0];
+
+	if (render == AAVE_RENDER_AMBISONICS) {
+		aave_ambisonics_add_sound(aave, sound, z, u[0], frames * 2,
+					gain, gain_prev, elevation, azimuth);
+	} else {
+		/* DFT bus 2: current block with current parameters. */
+		aave_hrtf_bus_add(aave, ydft, 2, y, hrtf, frames * 2,
+						sound->stride, gain, render);
+
+		/* DFT bus 0: current block with previous parameters. */
+		aave_hrtf_bus_add(aave, ydft, 0, y, sound->hrtf,
+				frames * 2, sound->stride, gain_prev, render);
+	}
+
+	/*
+	 * When the fade-out is done, forget the last block, so that it is
+	 * not added to DFT bus 1 if the sound fades in again later.
+	 */
+	if (!fade_samples) {
+		memset(sound->dft, 0, 2 * sizeof(sound->dft[0]) * frames);
+		ears = 0;
+	}
+	sound->ears = ears;
 
 	/* Remember the parameters used for the current block. */
+	sound->silent = silent || !fade_samples;
 	sound->fade_samples = fade_samples;
 	sound->distance = distance;
 	sound->hrtf[0] = hrtf[0];
 	sound->hrtf[1] = hrtf[1];
+
+	return 1;
+}
+
+/**
+ * Select the sounds of the auralisation world @p aave to render in the
+ * next audio block, according to the render budget aave->max_sounds.
+ *
+ * The sounds are ranked by their estimated level: the attenuation with
+ * distance, the fade-in/out gain and the average gain of the material
+ * absorption filter. The sounds that do not fit in the budget are marked
+ * as culled, and fade out like sounds that become inaudible.
+ *
+ * To avoid sorting, the sounds are ranked into classes of AAVE_CULL_STEP
+ * dB, and the sounds of the class that crosses the budget are taken in
+ * list order. This takes two passes over the sounds, with no memory
+ * allocation.
+ */
+static void aave_hrtf_cull_sounds(struct aave *aave)
+{
+	unsigned count[AAVE_CULL_CLASSES];
+	unsigned i, j, k, n, quota;
+	struct aave_sound *s;
+	float level;
+
+	/* First pass: estimate the level of each sound and rank it. */
+	memset(count, 0, sizeof count);
+	for (i = 0; i < AAVE_MAX_REFLECTIONS; i++) {
+		for (s = aave->sounds[i]; s; s = s->next) {
+			s->culled = 0;
+			if (!s->audible && !s->fade_samples)
+				continue;
+			level = attenuation(s->distance_current)
+							* s->filter_gain;
+			if (!s->audible)
+				level *= (float)s->fade_samples
+							/ AAVE_FADE_SAMPLES;
+			s->level = level;
+			count[cull_class(level)]++;
+		}
+	}
+
+	/* Find the class that crosses the budget. */
+	n = 0;
+	for (k = 0; k < AAVE_CULL_CLASSES; k++) {
+		if (n + count[k] > aave->max_sounds)
+			break;
+		n += count[k];
+	}
+	if (k == AAVE_CULL_CLASSES)
+		return;
+	quota = aave->max_sounds - n;
+
+	/* Second pass: cull the sounds that do not fit in the budget. */
+	for (i = 0; i < AAVE_MAX_REFLECTIONS; i++) {
+		for (s = aave->sounds[i]; s; s = s->next) {
+			if (!s->audible && !s->fade_samples)
+				continue;
+			j = cull_class(s->level);
+			if (j < k)
+				continue;
+			if (j == k && quota > 0) {
+				quota--;
+				continue;
+			}
+			s->culled = 1;
+		}
+	}
+}
+
+/**
+ * Perform the last pass of the IDFT of the previous (@p a) and current
+ * (@p b) parameters DFT of @p frames frames (see idft_passes()),
+ * crossfade them, apply the gain @p g, and store the result, unclipped,
+ * in the @p frames samples pointed by @p y, @p stride samples apart.
+ *
+ * Only the second half of the IDFT is calculated, the one that is not
+ * corrupted by the circular convolution (overlap-save method).
+ */
+static void aave_hrtf_output(const float *a, const float *b, float *y,
+				unsigned stride, unsigned frames, float g)
+{
+	const struct complex { float real; float imag; } *A0, *A1, *B0, *B1;
+	float f0, f1, f2, f3, a2, a3, b2, b3;
+	unsigned i, h, n;
+
+	n = frames * 2;
+	h = frames / 2;
+	A0 = (const struct complex *)a;
+	A1 = (const struct complex *)a + n / 4;
+	B0 = (const struct complex *)b;
+	B1 = (const struct complex *)b + n / 4;
+
+	for (i = 0; i < h; i++) {
+		/* IDFT N=n/4, samples n/2 + i and 3n/4 + i. */
+		f0 = A0[i].real;
+		f1 = A0[i].imag;
+		f2 = 2 * A1[i].real;
+		f3 = 2 * A1[i].imag;
+		a2 = (f0 + f1 - f2) / n;
+		a3 = (f0 - f1 + f3) / n;
+		f0 = B0[i].real;
+		f1 = B0[i].imag;
+		f2 = 2 * B1[i].real;
+		f3 = 2 * B1[i].imag;
+		b2 = (f0 + f1 - f2) / n;
+		b3 = (f0 - f1 + f3) / n;
+
+		y[i * stride] = g * (a2 * fade_out_gain(i, frames)
+					+ b2 * fade_in_gain(i, frames));
+		y[(i + h) * stride] = g * (a3 * fade_out_gain(i + h, frames)
+					+ b3 * fade_in_gain(i + h, frames));
+	}
 }
 
 /**
@@ -408,15 +1141,18 @@ static void aave_hrtf_add_sound(struct aave *aave, struct aave_sound *sound,
  * @p frames is the number of frames to generate.
  * @p delay is the number of frames of pre-delay to apply to all sounds
  * to account for audio user blocks larger than the size of the HRTFs.
+ * The left and right channels are stored in @p y[0] and @p y[1],
+ * @p stride samples apart, scaled by @p scale, which is either the HRTF
+ * output buffer or the caller's memory (see aave_render()).
  */
 static void aave_hrtf_fill_output_buffer(struct aave *aave, unsigned delay,
-							unsigned frames)
+			unsigned frames, float *y[2], unsigned stride, float scale)
 {
-	unsigned i, c;
+	unsigned i, c, n;
 	struct aave_sound *s;
 	float ydft[3][2][AAVE_MAX_HRTF * 4];
-	int y[3][AAVE_MAX_HRTF * 4];
-	int x, *overlap_add_buffer;
+	float *a, *b, *bus2, *save;
+	int ambisonics;
 
 	/* Reset the DFT busses. */
 	for (i = 0; i < 3; i++)
@@ -424,88 +1160,346 @@ static void aave_hrtf_fill_output_buffer(struct aave *aave, unsigned delay,
 			memset(ydft[i][c], 0,
 					2 * sizeof(ydft[0][0][0]) * frames);
 
-	/* Add all audible sounds to the DFT busses. */
-	for (i = 0; i <= aave->reflections; i++)
+	/* Switch to the HRTF set selected last, if any. */
+	aave_hrtf_lookup_apply(aave);
+
+	/* Distances and directions of the sounds for this block. */
+	aave_get_directions(aave);
+
+	/* Select the sounds within the render budget. */
+	if (aave->max_sounds)
+		aave_hrtf_cull_sounds(aave);
+	else
+		for (i = 0; i < AAVE_MAX_REFLECTIONS; i++)
+			for (s = aave->sounds[i]; s; s = s->next)
+				s->culled = 0;
+
+	/*
+	 * Add all audible sounds to the DFT busses, including the sounds
+	 * above the current order of reflections that are fading out.
+	 */
+	n = 0;
+	for (i = 0; i < AAVE_MAX_REFLECTIONS; i++)
 		for (s = aave->sounds[i]; s; s = s->next)
-			aave_hrtf_add_sound(aave, s, ydft, delay, frames);
+			n += aave_hrtf_add_sound(aave, s, ydft, delay, frames,
+							aave->render[i]);
+	aave->quality.sounds = n;
+
+	/* Add the direction clusters to the DFT busses. */
+	if (aave->nclusters)
+		aave_hrtf_clusters_add(aave, ydft, frames * 2);
+
+	ambisonics = aave->ambisonics && aave->ambisonics->active;
 
 	/* Generate the left and right channels. */
 	for (c = 0; c < 2; c++) {
-		overlap_add_buffer = aave->hrtf_overlap_add_buffer[c];
-
-		/* Convert the 3 DFT busses to the time domain. */
-		for (i = 0; i < 3; i++)
-			idft(y[i], ydft[i][c], frames * 2);
+		a = ydft[0][c];
+		b = ydft[1][c];
+		bus2 = ydft[2][c];
+		save = aave->hrtf_overlap_save_buffer[c];
 
-		for (i = 0; i < frames; i++) {
-			x = ((overlap_add_buffer[i] + y[0][i])
-						* fade_out_gain(i, frames)
-				+ (y[1][i+frames] + y[2][i])
-						* fade_in_gain(i, frames));
-			if (!aave->reverb_active) x *= aave->gain;
-			/* Clip samples that overflow signed 16 bits. */
-			if (x > 32767)
-				x = 32767;
-			else if (x < -32768)
-				x = -32768;
-			aave->hrtf_output_buffer[i * 2 + c] = x;
-		}
+		/*
+		 * Previous parameters: DFT bus 2 of the previous block followed
+		 * by DFT bus 0, delayed by one block (odd frequencies negated).
+		 */
+		for (i = 0; i < frames; i++)
+			a[i] = save[i] + a[i];
+		for ( ; i < frames * 2; i++)
+			a[i] = save[i] - a[i];
 
+		/* Current parameters: DFT bus 1 followed by DFT bus 2. */
 		for (i = 0; i < frames; i++)
-			overlap_add_buffer[i] = y[2][i+frames];
+			b[i] += bus2[i];
+		for ( ; i < frames * 2; i++)
+			b[i] -= bus2[i];
+
+		memcpy(save, bus2, 2 * sizeof(bus2[0]) * frames);
+
+		/* Add the Ambisonics bus, decoded to binaural. */
+		if (ambisonics)
+			aave_ambisonics_decode(aave, a, b, c, frames);
+
+		/* Convert to the time domain and crossfade. */
+		idft_passes(a, frames * 2);
+		idft_passes(b, frames * 2);
+		aave_hrtf_output(a, b, y[c], stride, frames, scale);
+	}
+
+	/* Reset the Ambisonics bus. */
+	if (ambisonics) {
+		for (i = 0; i < 2; i++)
+			for (c = 0; c < AAVE_AMBISONICS_CHANNELS; c++)
+				memset(aave->ambisonics->bus[i][c], 0,
+					2 * sizeof(ydft[0][0][0]) * frames);
+		aave->ambisonics->active = 0;
 	}
 }
 
 /**
- * Generate @p n 16-bit 2-channel frames of the auralisation world @p aave
- * and put them in the memory location pointed by @p buf.
+ * Generate @p n 2-channel frames of the auralisation world @p aave
+ * and put them in the memory location pointed by @p buf16, as interleaved
+ * 16-bit samples, clipped, or, if @p buf16 is 0, in the memory locations
+ * pointed by @p left and @p right, as float samples @p stride samples
+ * apart, unclipped.
+ *
+ * The float audio blocks that the request covers whole are rendered
+ * directly into the caller's memory, without the HRTF output buffer;
+ * the reverberation tail, if active, is then mixed in place.
  */
-void aave_get_audio(struct aave *aave, short *buf, unsigned n)
+static void aave_render(struct aave *aave, short *buf16, float *left,
+				float *right, unsigned stride, unsigned n)
 {
 	unsigned frames, index;
-	unsigned k;
-	
-	short* reverb_buf = buf;
+	unsigned i, k;
+	double t = 0;
+	float *y, x[AAVE_MAX_HRTF * 4];
+	float *out[2], g;
 	unsigned l = n;
+	int reverb;
+
+	if (aave->quality.target > 0)
+		t = aave_quality_clock();
+
+	/* The gain is applied with the reverberation tail, if active. */
+	reverb = __atomic_load_n(&aave->reverb_active, __ATOMIC_RELAXED);
+	g = reverb ? 1 : aave->gain;
+
+	/* The sources read from memory advance with the frames generated. */
+	aave_advance_sources(aave, n);
 
 	frames = 2 * aave->hrtf_frames;
 	index = aave->hrtf_output_buffer_index;
 
 	while (n) {
 		k = frames - index;
+		if (k == 0 && !buf16 && n >= frames) {
+			/* Zero-copy: render the whole block in place. */
+			out[0] = left;
+			out[1] = right;
+			aave_hrtf_fill_output_buffer(aave, n, frames, out,
+					stride, g / AAVE_F32_SCALE);
+			n -= frames;
+			if (reverb)
+				aave_reverb(aave, out, stride, frames, n,
+							1. / AAVE_F32_SCALE);
+			left += frames * stride;
+			right += frames * stride;
+			continue;
+		}
 		if (k == 0) {
-			aave_hrtf_fill_output_buffer(aave, n, frames);
+			out[0] = aave->hrtf_output_buffer;
+			out[1] = aave->hrtf_output_buffer + 1;
+			aave_hrtf_fill_output_buffer(aave, n, frames, out, 2, g);
 			index = 0;
 			k = frames;
 		}
 		if (k > n) k = n;
 
-		memcpy(buf, aave->hrtf_output_buffer + index * 2, k * 4);
-
+		y = aave->hrtf_output_buffer + index * 2;
 		n -= k;
 		index += k;
-		buf += k * 2;
+
+		/* Add the reverberation tail (and the gain). */
+		if (reverb) {
+			memcpy(x, y, k * 2 * sizeof(x[0]));
+			y = x;
+			out[0] = x;
+			out[1] = x + 1;
+			aave_reverb(aave, out, 2, k, n, 1);
+		}
+
+		if (!buf16) {
+			for (i = 0; i < k; i++) {
+				left[i * stride] = y[i * 2]
+						* (1. / AAVE_F32_SCALE);
+				right[i * stride] = y[i * 2 + 1]
+						* (1. / AAVE_F32_SCALE);
+			}
+			left += k * stride;
+			right += k * stride;
+			continue;
+		}
+
+		/* Clip samples that overflow signed 16 bits. */
+		for (i = 0; i < k * 2; i++) {
+			if (y[i] > 32767)
+				buf16[i] = 32767;
+			else if (y[i] < -32768)
+				buf16[i] = -32768;
+			else
+				buf16[i] = y[i];
+		}
+		buf16 += k * 2;
 	}
 
 	aave->hrtf_output_buffer_index = index;	
-		
-	if (aave->reverb_active) {
-        aave_reverb_jot(aave,reverb_buf,l);
-    }	
+
+	/* Hand the next frames to the reverberation worker, if running. */
+	if (reverb)
+		aave_reverb_ahead(aave, l);
+
+	if (aave->quality.target > 0)
+		aave_quality_account(aave, aave_quality_clock() - t, l);
+}
+
+/**
+ * Generate @p n 16-bit 2-channel frames of the auralisation world @p aave
+ * and put them in the memory location pointed by @p buf.
+ */
+void aave_get_audio(struct aave *aave, short *buf, unsigned n)
+{
+	aave_render(aave, buf, 0, 0, 0, n);
+}
+
+/**
+ * Generate @p n float 2-channel frames of the auralisation world @p aave
+ * and put them in the memory location pointed by @p buf.
+ * The samples are in the range [-1;1[ (full scale of the 16-bit samples of
+ * aave_get_audio()), but are not clipped.
+ */
+void aave_get_audio_f32(struct aave *aave, float *buf, unsigned n)
+{
+	aave_render(aave, 0, buf, buf + 1, 2, n);
+}
+
+/**
+ * Generate @p n float frames of the auralisation world @p aave, as
+ * aave_get_audio_f32() does, and put the left and right channels in the
+ * memory locations pointed by @p left and @p right, with consecutive
+ * samples of each channel @p stride samples apart.
+ * For example, for planar buffers (such as JACK port buffers),
+ * @p stride is 1; for interleaved 2-channel buffers, @p right is
+ * @p left + 1 and @p stride is 2.
+ *
+ * When @p n covers whole HRTF audio blocks (2 * aave->hrtf_frames frames),
+ * these are rendered directly into @p left and @p right (such as an ALSA
+ * mmap area), with no intermediate copy.
+ */
+void aave_get_audio_channels(struct aave *aave, float *left, float *right,
+					unsigned stride, unsigned n)
+{
+	aave_render(aave, 0, left, right, stride, n);
+}
+
+/**
+ * Select the rendering mode @p render (AAVE_RENDER_*) of the sounds of
+ * reflection order @p order and above in the auralisation world @p aave.
+ * For example, to render the direct sound and 1st order reflections each
+ * with its own HRTF pair, and higher orders by direction clusters:
+ * @code
+ * aave_set_render(aave, 2, AAVE_RENDER_CLUSTER);
+ * @endcode
+ * Orders up to K get the full HRTF processing, and the cheaper modes
+ * are meant for the orders above, with aave_set_render(aave, K + 1, mode).
+ * The first AAVE_RENDER_AMBISONICS calculates the Ambisonics decoder of the
+ * HRTF sets, so it must be called from the thread that selects them.
+ */
+void aave_set_render(struct aave *aave, unsigned order, unsigned render)
+{
+	unsigned i;
+
+	/* Allocate the direction clusters the first time they are needed. */
+	if ((render == AAVE_RENDER_CLUSTER || render == AAVE_RENDER_COARSE)
+	    && !aave->clusters) {
+		aave->clusters = malloc(AAVE_MAX_CLUSTERS
+						* sizeof *aave->clusters);
+		if (!aave->clusters)
+			return;
+		aave->nclusters = 0;
+		memset(aave->cluster_hash, 0, sizeof aave->cluster_hash);
+	}
+
+	/*
+	 * Allocate the Ambisonics bus the first time it is needed, and the
+	 * decoders of the HRTF sets selected so far.
+	 */
+	if (render == AAVE_RENDER_AMBISONICS) {
+		if (!aave->ambisonics)
+			aave->ambisonics = calloc(1, sizeof *aave->ambisonics);
+		if (!aave->ambisonics || aave_hrtf_lookup_decoder(aave))
+			return;
+	}
+
+	for (i = order; i < AAVE_MAX_REFLECTIONS; i++)
+		aave->render[i] = render;
+}
+
+/**
+ * Allocate the ring buffer of @p source, if it has none: when it is
+ * initialised, or, after its samples were read from memory (see
+ * source.c), when it starts streaming (see stream.c) or before samples
+ * are put in it again.
+ * Returns 0 if out of memory, or 1 otherwise.
+ */
+int aave_alloc_source_buffer(struct aave_source *source)
+{
+	if (!source->buffer)
+		source->buffer = calloc(AAVE_SOURCE_BUFSIZE,
+						sizeof *source->buffer);
+
+	return source->buffer != 0;
 }
 
+/**
+ * Put the sample @p x in the ring buffer of @p source, at index @p i,
+ * and update the count of trailing @p silence samples.
+ */
+#define PUT_SAMPLE(source, i, x, silence) do {				\
+		(source)->buffer[i] = (x);				\
+		if ((source)->buffer[i] <= AAVE_SILENCE_LEVEL		\
+		    && (source)->buffer[i] >= -AAVE_SILENCE_LEVEL) {	\
+			if ((silence) < AAVE_SOURCE_BUFSIZE)		\
+				(silence)++;				\
+		} else							\
+			(silence) = 0;					\
+	} while (0)
+
 /**
  * Put the @p n frames pointed by @p audio in the ring buffer of @p source.
+ * The trailing silent samples are counted, so that the sounds of sources
+ * that are not playing are not processed.
+ * Returns 0 on success, or -1 if the source has no ring buffer, as its
+ * samples are read from memory (see aave_alloc_source_buffer()).
  */
-void aave_put_audio(struct aave_source *source, const short *audio, unsigned n)
+int aave_put_audio(struct aave_source *source, const short *audio, unsigned n)
 {
 	unsigned i = source->buffer_index;
-	short *buf = source->buffer;	
+	unsigned silence = source->silence;
+
+	if (!source->buffer)
+		return -1;
+
+	while (n--) {
+		i = (i + 1) & (AAVE_SOURCE_BUFSIZE - 1);
+		PUT_SAMPLE(source, i, *audio++, silence);
+	}
+
+	source->buffer_index = i;
+	source->silence = silence;
+	return 0;
+}
+
+/**
+ * Put the @p n float frames pointed by @p audio, in the range [-1;1],
+ * in the ring buffer of @p source, as aave_put_audio() does.
+ * The samples are not clipped to the range of 16-bit samples.
+ * Returns 0 on success, or -1 if the source has no ring buffer.
+ */
+int aave_put_audio_f32(struct aave_source *source, const float *audio,
+								unsigned n)
+{
+	unsigned i = source->buffer_index;
+	unsigned silence = source->silence;
+
+	if (!source->buffer)
+		return -1;
 
 	while (n--) {
 		i = (i + 1) & (AAVE_SOURCE_BUFSIZE - 1);
-		buf[i] = *audio++;
+		PUT_SAMPLE(source, i, *audio++ * AAVE_F32_SCALE, silence);
 	}
 
 	source->buffer_index = i;
+	source->silence = silence;
+	return 0;
 }
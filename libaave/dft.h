@@ -52,11 +52,147 @@
  * @endcode
  * This will insert a static dft() function in your source code file
  * that calculates the Fourier coefficients of an array of short integers.
+ *
+ * On processors with SSE, the radix-4 passes run the butterflies of 2
+ * consecutive complex values at once in SSE registers, with the same
+ * operations, and therefore the same results, as the scalar butterflies.
+ * Define AAVE_DFT_SCALAR before including this file to use the scalar
+ * butterflies only. The SSE butterflies are not used if other butterflies
+ * are plugged in (see below).
+ *
+ * The twiddle factors come from the single dftsincos table, generated at
+ * build time by tools/dftsincos.c, which every size reads sequentially in
+ * the bit-reversed order of the blocks of each pass, so there are no
+ * per-size tables to build at initialisation. The butterflies are macros,
+ * so that other implementations can be plugged in by defining
+ * DFT_BUTTERFLY0() and DFT_BUTTERFLY() before including this file.
  */
 
 /** Table with the pre-calculated sin() and cos() values. */
 extern const float dftsincos[][2];
 
+#ifndef DFT_BUTTERFLY
+/**
+ * Radix-2 butterfly of dft() of the complex values @p a and @p b,
+ * without twiddle factor (first block of each pass).
+ */
+#define DFT_BUTTERFLY0(a, b) do {					\
+		float f0 = (a).real, f1 = (a).imag;			\
+		float f2 = (b).real, f3 = (b).imag;			\
+		(a).real = f0 + f2;					\
+		(a).imag = f0 - f2;					\
+		(b).real = f1;						\
+		(b).imag = - f3;					\
+	} while (0)
+
+/**
+ * Radix-2 butterfly of dft() of the complex values @p a and @p b,
+ * with the twiddle factor @p cosx, @p sinx.
+ */
+#define DFT_BUTTERFLY(a, b, cosx, sinx) do {				\
+		float f0 = (a).real, f1 = (a).imag;			\
+		float f2 = (b).real, f3 = (b).imag;			\
+		float f4 = f2 * (cosx) + f3 * (sinx);			\
+		float f5 = f3 * (cosx) - f2 * (sinx);			\
+		(a).real = f0 + f4;					\
+		(a).imag = f1 + f5;					\
+		(b).real = f0 - f4;					\
+		(b).imag = f5 - f1;					\
+	} while (0)
+
+#if defined(__SSE__) && !defined(AAVE_DFT_SCALAR)
+#define DFT_SSE
+#include <xmmintrin.h> /* _mm_add_ps() */
+
+/**
+ * DFT_BUTTERFLY0() of the 2 consecutive complex values in each of the SSE
+ * registers @p a and @p b; @p sign holds the sign bits of the imaginary
+ * parts (_mm_setr_ps(0, -0.f, 0, -0.f)).
+ */
+#define DFT_BUTTERFLY0_SSE(a, b, sign) do {				\
+		__m128 v0 = _mm_shuffle_ps(a, a, _MM_SHUFFLE(2, 2, 0, 0)); \
+		__m128 v1 = _mm_shuffle_ps(b, b, _MM_SHUFFLE(2, 2, 0, 0)); \
+		__m128 v2 = _mm_shuffle_ps(a, b, _MM_SHUFFLE(3, 1, 3, 1)); \
+		(a) = _mm_add_ps(v0, _mm_xor_ps(v1, sign));		\
+		(b) = _mm_xor_ps(_mm_shuffle_ps(v2, v2,			\
+				_MM_SHUFFLE(3, 1, 2, 0)), sign);	\
+	} while (0)
+
+/**
+ * DFT_BUTTERFLY() of the 2 consecutive complex values in each of the SSE
+ * registers @p a and @p b, with the twiddle factor @p cosx (in all lanes)
+ * and @p sinx (with the sign of the imaginary parts flipped); @p sign as
+ * in DFT_BUTTERFLY0_SSE().
+ */
+#define DFT_BUTTERFLY_SSE(a, b, cosx, sinx, sign) do {			\
+		__m128 v0 = _mm_add_ps(_mm_mul_ps(b, cosx),		\
+			_mm_mul_ps(_mm_shuffle_ps(b, b,			\
+				_MM_SHUFFLE(2, 3, 0, 1)), sinx));	\
+		(b) = _mm_sub_ps(_mm_xor_ps(a, sign), _mm_xor_ps(v0, sign)); \
+		(a) = _mm_add_ps(a, v0);				\
+	} while (0)
+
+/**
+ * Perform one radix-4 pass of dft() (the radix-2 stages of blocks of
+ * 2 * @p m and 4 * @p m complex values) of the @p n point DFT pointed by
+ * @p X, for @p m > 2, with the SSE butterflies.
+ */
+static void dft_pass_sse(float *X, unsigned m, unsigned n)
+{
+	const __m128 sign = _mm_setr_ps(0, -0.f, 0, -0.f);
+	__m128 a0, a1, b0, b1, c0, s0, c1, s1, c2, s2;
+	float *X0 = X, *X1 = X + m * 2;
+	unsigned i, j, k;
+
+	/* Offsets in floats: m / 2 complex values are m floats. */
+	c0 = _mm_set1_ps(dftsincos[0][1]);
+	s0 = _mm_setr_ps(dftsincos[0][0], -dftsincos[0][0],
+				dftsincos[0][0], -dftsincos[0][0]);
+	for (k = 0; k < m; k += 4) {
+		a0 = _mm_loadu_ps(X0 + k);
+		a1 = _mm_loadu_ps(X0 + k + m);
+		b0 = _mm_loadu_ps(X1 + k);
+		b1 = _mm_loadu_ps(X1 + k + m);
+		DFT_BUTTERFLY0_SSE(a0, b0, sign);
+		DFT_BUTTERFLY0_SSE(a1, b1, sign);
+		DFT_BUTTERFLY0_SSE(a0, a1, sign);
+		DFT_BUTTERFLY_SSE(b0, b1, c0, s0, sign);
+		_mm_storeu_ps(X0 + k, a0);
+		_mm_storeu_ps(X0 + k + m, a1);
+		_mm_storeu_ps(X1 + k, b0);
+		_mm_storeu_ps(X1 + k + m, b1);
+	}
+	j = 0;
+	for (i = 4 * m; i < n; i += 4 * m) {
+		c0 = _mm_set1_ps(dftsincos[j][1]);
+		s0 = _mm_setr_ps(dftsincos[j][0], -dftsincos[j][0],
+					dftsincos[j][0], -dftsincos[j][0]);
+		c1 = _mm_set1_ps(dftsincos[2*j+1][1]);
+		s1 = _mm_setr_ps(dftsincos[2*j+1][0], -dftsincos[2*j+1][0],
+				dftsincos[2*j+1][0], -dftsincos[2*j+1][0]);
+		c2 = _mm_set1_ps(dftsincos[2*j+2][1]);
+		s2 = _mm_setr_ps(dftsincos[2*j+2][0], -dftsincos[2*j+2][0],
+				dftsincos[2*j+2][0], -dftsincos[2*j+2][0]);
+		j++;
+		for (k = i; k < i + m; k += 4) {
+			a0 = _mm_loadu_ps(X0 + k);
+			a1 = _mm_loadu_ps(X0 + k + m);
+			b0 = _mm_loadu_ps(X1 + k);
+			b1 = _mm_loadu_ps(X1 + k + m);
+			DFT_BUTTERFLY_SSE(a0, b0, c0, s0, sign);
+			DFT_BUTTERFLY_SSE(a1, b1, c0, s0, sign);
+			DFT_BUTTERFLY_SSE(a0, a1, c1, s1, sign);
+			DFT_BUTTERFLY_SSE(b0, b1, c2, s2, sign);
+			_mm_storeu_ps(X0 + k, a0);
+			_mm_storeu_ps(X0 + k + m, a1);
+			_mm_storeu_ps(X1 + k, b0);
+			_mm_storeu_ps(X1 + k + m, b1);
+		}
+	}
+}
+#endif /* DFT_SSE */
+#endif /* DFT_BUTTERFLY */
+
 /**
  * This dft function calculates the @p n point discrete Fourier transform
  * of the zero-padded real-input data values pointed by @p x
@@ -76,15 +212,24 @@ extern const float dftsincos[][2];
  * - X[N/2].imag = 0;
  * - X[N/2+i].real = X[N/2-i].real;
  * - X[N/2+i].imag = - X[N/2-i].imag;
+ *
+ * Each pass over the data performs two radix-2 stages at once (radix-4),
+ * halving the memory traffic, with the same operations, and therefore the
+ * same results, as performing them one at a time. Define AAVE_DFT_RADIX2
+ * before including this file to use one radix-2 stage per pass instead,
+ * for reference.
  */
 static void dft(float *X, const DFT_TYPE *x, unsigned n)
 {
 	struct complex { float real; float imag; } *X0, *X1;
 	const DFT_TYPE *x0, *x1;
 	DFT_TYPE a, b;
-	float f0, f1, f2, f3, f4, f5;
 	float cosx, sinx;
 	unsigned i, j, k, m;
+#ifndef AAVE_DFT_RADIX2
+	float cos1, sin1, cos2, sin2;
+	unsigned h;
+#endif
 
 	/* DFT N=4 */
 	x0 = x;
@@ -100,35 +245,58 @@ static void dft(float *X, const DFT_TYPE *x, unsigned n)
 		X1[i].imag = -b;
 	}
 
-	/* DFT N=8, N=16, ... , N=m */
-	for (m = n / 8; m; m /= 2) {
+	m = n / 8;
+
+#ifndef AAVE_DFT_RADIX2
+	/* DFT N=8 and N=16, N=32 and N=64, ... , 2 stages per pass */
+	for ( ; m > 1; m /= 4) {
+#ifdef DFT_SSE
+		if (m > 2) {
+			dft_pass_sse(X, m, n);
+			continue;
+		}
+#endif
+		h = m / 2;
 		X1 = (struct complex *)X + m;
-		for (i = 0; i < m; i++) {
-			f0 = X0[i].real;
-			f1 = X0[i].imag;
-			f2 = X1[i].real;
-			f3 = X1[i].imag;
-			X0[i].real = f0 + f2;
-			X0[i].imag = f0 - f2;
-			X1[i].real = f1;
-			X1[i].imag = - f3;
+		sinx = dftsincos[0][0];
+		cosx = dftsincos[0][1];
+		for (k = 0; k < h; k++) {
+			DFT_BUTTERFLY0(X0[k], X1[k]);
+			DFT_BUTTERFLY0(X0[k+h], X1[k+h]);
+			DFT_BUTTERFLY0(X0[k], X0[k+h]);
+			DFT_BUTTERFLY(X1[k], X1[k+h], cosx, sinx);
 		}
 		j = 0;
+		for (i = 2 * m; i < n / 2; i += 2 * m) {
+			sinx = dftsincos[j][0];
+			cosx = dftsincos[j][1];
+			sin1 = dftsincos[2*j+1][0];
+			cos1 = dftsincos[2*j+1][1];
+			sin2 = dftsincos[2*j+2][0];
+			cos2 = dftsincos[2*j+2][1];
+			j++;
+			for (k = i; k < i + h; k++) {
+				DFT_BUTTERFLY(X0[k], X1[k], cosx, sinx);
+				DFT_BUTTERFLY(X0[k+h], X1[k+h], cosx, sinx);
+				DFT_BUTTERFLY(X0[k], X0[k+h], cos1, sin1);
+				DFT_BUTTERFLY(X1[k], X1[k+h], cos2, sin2);
+			}
+		}
+	}
+#endif
+
+	/* DFT N=8, N=16, ... , N=m, 1 stage per pass */
+	for ( ; m; m /= 2) {
+		X1 = (struct complex *)X + m;
+		for (i = 0; i < m; i++)
+			DFT_BUTTERFLY0(X0[i], X1[i]);
+		j = 0;
 		while ((i += m) < n / 2) {
 			sinx = dftsincos[j][0];
 			cosx = dftsincos[j][1];
 			j++;
 			for (k = 0; k < m; k++) {
-				f0 = X0[i].real;
-				f1 = X0[i].imag;
-				f2 = X1[i].real;
-				f3 = X1[i].imag;
-				f4 = f2 * cosx + f3 * sinx;
-				f5 = f3 * cosx - f2 * sinx;
-				X0[i].real = f0 + f4;
-				X0[i].imag = f1 + f5;
-				X1[i].real = f0 - f4;
-				X1[i].imag = f5 - f1;
+				DFT_BUTTERFLY(X0[i], X1[i], cosx, sinx);
 				i++;
 			}
 		}
@@ -0,0 +1,2 @@
+/* This file was automatically generated. See tools/distance.c */
+const float aave_distance_decay[]={9.997700e-01,9.995401e-01,9.993102e-01,9.990803e-01,9.988505e-01,9.986208e-01,9.983911e-01,9.981615e-01,9.979319e-01,9.977024e-01,9.974729e-01,9.972435e-01,9.970141e-01,9.967848e-01,9.965555e-01,9.963263e-01,9.960972e-01,9.958681e-01,9.956390e-01,9.954100e-01,9.951811e-01,9.949522e-01,9.947234e-01,9.944946e-01,9.942658e-01,9.940372e-01,9.938085e-01,9.935800e-01,9.933514e-01,9.931230e-01,9.928945e-01,9.926662e-01,9.924379e-01,9.922096e-01,9.919814e-01,9.917532e-01,9.915251e-01,9.912971e-01,9.910691e-01,9.908411e-01,9.906132e-01,9.903854e-01,9.901576e-01,9.899299e-01,9.897022e-01,9.894746e-01,9.892470e-01,9.890195e-01,9.887920e-01,9.885646e-01,9.883372e-01,9.881099e-01,9.878826e-01,9.876554e-01,9.874282e-01,9.872011e-01,9.869741e-01,9.867471e-01,9.865201e-01,9.862932e-01,9.860664e-01,9.858396e-01,9.856128e-01,9.853861e-01,9.851595e-01,9.849329e-01,9.847064e-01,9.844799e-01,9.842535e-01,9.840271e-01,9.838008e-01,9.835745e-01,9.833483e-01,9.831221e-01,9.828960e-01,9.826699e-01,9.824439e-01,9.822179e-01,9.819920e-01,9.817662e-01,9.815404e-01,9.813146e-01,9.810889e-01,9.808633e-01,9.806377e-01,9.804121e-01,9.801866e-01,9.799612e-01,9.797358e-01,9.795104e-01,9.792852e-01,9.790599e-01,9.788347e-01,9.786096e-01,9.783845e-01,9.781595e-01,9.779345e-01,9.777096e-01,9.774847e-01,9.772599e-01,9.770351e-01,9.768104e-01,9.765857e-01,9.763611e-01,9.761366e-01,9.759121e-01,9.756876e-01,9.754632e-01,9.752388e-01,9.750145e-01,9.747903e-01,9.745661e-01,9.743419e-01,9.741178e-01,9.738938e-01,9.736698e-01,9.734458e-01,9.732219e-01,9.729981e-01,9.727743e-01,9.725506e-01,9.723269e-01,9.721033e-01,9.718797e-01,9.716561e-01,9.714327e-01,9.712092e-01,9.709858e-01,9.707625e-01,9.705392e-01,9.703160e-01,9.700928e-01,9.698697e-01,9.696467e-01,9.694236e-01,9.692007e-01,9.689778e-01,9.687549e-01,9.685321e-01,9.683093e-01,9.680866e-01,9.678639e-01,9.676413e-01,9.674188e-01,9.671963e-01,9.669738e-01,9.667514e-01,9.665291e-01,9.663068e-01,9.660845e-01,9.658623e-01,9.656402e-01,9.654181e-01,9.651960e-01,9.649740e-01,9.647521e-01,9.645302e-01,9.643083e-01,9.640866e-01,9.638648e-01,9.636431e-01,9.634215e-01,9.631999e-01,9.629784e-01,9.627569e-01,9.625354e-01,9.623141e-01,9.620927e-01,9.618714e-01,9.616502e-01,9.614290e-01,9.612079e-01,9.609868e-01,9.607658e-01,9.605448e-01,9.603239e-01,9.601030e-01,9.598822e-01,9.596614e-01,9.594407e-01,9.592200e-01,9.589994e-01,9.587788e-01,9.585583e-01,9.583379e-01,9.581174e-01,9.578971e-01,9.576768e-01,9.574565e-01,9.572363e-01,9.570161e-01,9.567960e-01,9.565759e-01,9.563559e-01,9.561360e-01,9.559160e-01,9.556962e-01,9.554764e-01,9.552566e-01,9.550369e-01,9.548173e-01,9.545976e-01,9.543781e-01,9.541586e-01,9.539391e-01,9.537197e-01,9.535004e-01,9.532811e-01,9.530618e-01,9.528426e-01,9.526234e-01,9.524043e-01,9.521853e-01,9.519663e-01,9.517473e-01,9.515284e-01,9.513096e-01,9.510908e-01,9.508720e-01,9.506533e-01,9.504347e-01,9.502161e-01,9.499975e-01,9.497790e-01,9.495606e-01,9.493422e-01,9.491238e-01,9.489055e-01,9.486873e-01,9.484691e-01,9.482509e-01,9.480328e-01,9.478148e-01,9.475968e-01,9.473788e-01,9.471609e-01,9.469431e-01,9.467253e-01,9.465076e-01,9.462899e-01,9.460722e-01,9.458546e-01,9.456371e-01,9.454196e-01,9.452021e-01,9.449847e-01,9.447674e-01,9.445501e-01,9.443328e-01,9.441156e-01,9.438985e-01,9.436814e-01,9.434644e-01,9.432474e-01,9.430304e-01,9.428135e-01,9.425967e-01,9.423799e-01,9.421631e-01,9.419464e-01,9.417298e-01,9.415132e-01,9.412966e-01,9.410801e-01,9.408637e-01,9.406473e-01,9.404309e-01,9.402146e-01,9.399984e-01,9.397822e-01,9.395660e-01,9.393499e-01,9.391339e-01,9.389179e-01,9.387019e-01,9.384860e-01,9.382702e-01,9.380544e-01,9.378386e-01,9.376229e-01,9.374073e-01,9.371917e-01,9.369761e-01,9.367606e-01,9.365452e-01,9.363298e-01,9.361144e-01,9.358991e-01,9.356838e-01,9.354686e-01,9.352535e-01,9.350384e-01,9.348233e-01,9.346083e-01,9.343933e-01,9.341784e-01,9.339636e-01,9.337487e-01,9.335340e-01,9.333193e-01,9.331046e-01,9.328900e-01,9.326754e-01,9.324609e-01,9.322464e-01,9.320320e-01,9.318177e-01,9.316033e-01,9.313891e-01,9.311749e-01,9.309607e-01,9.307466e-01,9.305325e-01,9.303185e-01,9.301045e-01,9.298906e-01,9.296767e-01,9.294629e-01,9.292491e-01,9.290354e-01,9.288217e-01,9.286081e-01,9.283945e-01,9.281810e-01,9.279675e-01,9.277540e-01,9.275407e-01,9.273273e-01,9.271140e-01,9.269008e-01,9.266876e-01,9.264745e-01,9.262614e-01,9.260483e-01,9.258354e-01,9.256224e-01,9.254095e-01,9.251967e-01,9.249839e-01,9.247711e-01,9.245584e-01,9.243458e-01,9.241332e-01,9.239206e-01,9.237081e-01,9.234957e-01,9.232833e-01,9.230709e-01,9.228586e-01,9.226464e-01,9.224342e-01,9.222220e-01,9.220099e-01,9.217978e-01,9.215858e-01,9.213738e-01,9.211619e-01,9.209501e-01,9.207382e-01,9.205265e-01,9.203147e-01,9.201031e-01,9.198915e-01,9.196799e-01,9.194684e-01,9.192569e-01,9.190454e-01,9.188341e-01,9.186227e-01,9.184114e-01,9.182002e-01,9.179890e-01,9.177779e-01,9.175668e-01,9.173558e-01,9.171448e-01,9.169338e-01,9.167229e-01,9.165121e-01,9.163013e-01,9.160905e-01,9.158798e-01,9.156692e-01,9.154586e-01,9.152480e-01,9.150375e-01,9.148271e-01,9.146166e-01,9.144063e-01,9.141960e-01,9.139857e-01,9.137755e-01,9.135653e-01,9.133552e-01,9.131451e-01,9.129351e-01,9.127251e-01,9.125152e-01,9.123053e-01,9.120955e-01,9.118857e-01,9.116760e-01,9.114663e-01,9.112567e-01,9.110471e-01,9.108375e-01,9.106280e-01,9.104186e-01,9.102092e-01,9.099998e-01,9.097905e-01,9.095813e-01,9.093721e-01,9.091629e-01,9.089538e-01,9.087448e-01,9.085358e-01,9.083268e-01,9.081179e-01,9.079090e-01,9.077002e-01,9.074914e-01,9.072827e-01,9.070740e-01,9.068654e-01,9.066568e-01,9.064483e-01,9.062398e-01,9.060314e-01,9.058230e-01,9.056146e-01,9.054064e-01,9.051981e-01,9.049899e-01,9.047818e-01,9.045737e-01,9.043656e-01,9.041576e-01,9.039497e-01,9.037417e-01,9.035339e-01,9.033261e-01,9.031183e-01,9.029106e-01,9.027029e-01,9.024953e-01,9.022877e-01,9.020802e-01,9.018727e-01,9.016653e-01,9.014579e-01,9.012506e-01,9.010433e-01,9.008360e-01,9.006289e-01,9.004217e-01,9.002146e-01,9.000076e-01,8.998006e-01,8.995936e-01,8.993867e-01,8.991798e-01,8.989730e-01,8.987663e-01,8.985595e-01,8.983529e-01,8.981463e-01,8.979397e-01,8.977332e-01,8.975267e-01,8.973202e-01,8.971139e-01,8.969075e-01,8.967012e-01,8.964950e-01,8.962888e-01,8.960827e-01,8.958766e-01,8.956705e-01,8.954645e-01,8.952585e-01,8.950526e-01,8.948468e-01,8.946410e-01,8.944352e-01,8.942295e-01,8.940238e-01,8.938182e-01,8.936126e-01,8.934071e-01,8.932016e-01,8.929961e-01,8.927908e-01,8.925854e-01,8.923801e-01,8.921749e-01,8.919697e-01,8.917645e-01,8.915594e-01,8.913544e-01,8.911493e-01,8.909444e-01,8.907395e-01,8.905346e-01,8.903298e-01,8.901250e-01,8.899203e-01,8.897156e-01,8.895109e-01,8.893064e-01,8.891018e-01,8.888973e-01,8.886929e-01,8.884885e-01,8.882841e-01,8.880798e-01,8.878756e-01,8.876714e-01,8.874672e-01,8.872631e-01,8.870590e-01,8.868550e-01,8.866510e-01,8.864471e-01,8.862432e-01,8.860394e-01,8.858356e-01,8.856318e-01,8.854281e-01,8.852245e-01,8.850209e-01,8.848173e-01,8.846138e-01,8.844104e-01,8.842069e-01,8.840036e-01,8.838002e-01,8.835970e-01,8.833937e-01,8.831906e-01,8.829874e-01,8.827843e-01,8.825813e-01,8.823783e-01,8.821754e-01,8.819725e-01,8.817696e-01,8.815668e-01,8.813640e-01,8.811613e-01,8.809587e-01,8.807560e-01,8.805535e-01,8.803509e-01,8.801485e-01,8.799460e-01,8.797436e-01,8.795413e-01,8.793390e-01,8.791368e-01,8.789346e-01,8.787324e-01,8.785303e-01,8.783282e-01,8.781262e-01,8.779242e-01,8.777223e-01,8.775204e-01,8.773186e-01,8.771168e-01,8.769151e-01,8.767134e-01,8.765118e-01,8.763102e-01,8.761086e-01,8.759071e-01,8.757056e-01,8.755042e-01,8.753029e-01,8.751015e-01,8.749003e-01,8.746990e-01,8.744979e-01,8.742967e-01,8.740956e-01,8.738946e-01,8.736936e-01,8.734927e-01,8.732918e-01,8.730909e-01,8.728901e-01,8.726893e-01,8.724886e-01,8.722879e-01,8.720873e-01,8.718867e-01,8.716862e-01,8.714857e-01,8.712853e-01,8.710849e-01,8.708845e-01,8.706842e-01,8.704840e-01,8.702837e-01,8.700836e-01,8.698835e-01,8.696834e-01,8.694834e-01,8.692834e-01,8.690834e-01,8.688836e-01,8.686837e-01,8.684839e-01,8.682842e-01,8.680845e-01,8.678848e-01,8.676852e-01,8.674856e-01,8.672861e-01,8.670866e-01,8.668872e-01,8.666878e-01,8.664885e-01,8.662892e-01,8.660899e-01,8.658907e-01,8.656916e-01,8.654925e-01,8.652934e-01,8.650944e-01,8.648954e-01,8.646965e-01,8.644976e-01,8.642988e-01,8.641000e-01,8.639012e-01,8.637025e-01,8.635039e-01,8.633053e-01,8.631067e-01,8.629082e-01,8.627097e-01,8.625113e-01,8.623129e-01,8.621146e-01,8.619163e-01,8.617181e-01,8.615199e-01,8.613217e-01,8.611236e-01,8.609256e-01,8.607276e-01,8.605296e-01,8.603317e-01,8.601338e-01,8.599360e-01,8.597382e-01,8.595404e-01,8.593427e-01,8.591451e-01,8.589475e-01,8.587499e-01,8.585524e-01,8.583550e-01,8.581575e-01,8.579602e-01,8.577628e-01,8.575655e-01,8.573683e-01,8.571711e-01,8.569740e-01,8.567769e-01,8.565798e-01,8.563828e-01,8.561858e-01,8.559889e-01,8.557920e-01,8.555952e-01,8.553984e-01,8.552017e-01,8.550050e-01,8.548083e-01,8.546117e-01,8.544151e-01,8.542186e-01,8.540222e-01,8.538257e-01,8.536293e-01,8.534330e-01,8.532367e-01,8.530405e-01,8.528443e-01,8.526481e-01,8.524520e-01,8.522560e-01,8.520599e-01,8.518640e-01,8.516680e-01,8.514721e-01,8.512763e-01,8.510805e-01,8.508848e-01,8.506891e-01,8.504934e-01,8.502978e-01,8.501022e-01,8.499067e-01,8.497112e-01,8.495158e-01,8.493204e-01,8.491251e-01,8.489298e-01,8.487345e-01,8.485393e-01,8.483441e-01,8.481490e-01,8.479539e-01,8.477589e-01,8.475639e-01,8.473690e-01,8.471741e-01,8.469792e-01,8.467844e-01,8.465897e-01,8.463950e-01,8.462003e-01,8.460057e-01,8.458111e-01,8.456165e-01,8.454220e-01,8.452276e-01,8.450332e-01,8.448388e-01,8.446445e-01,8.444503e-01,8.442560e-01,8.440619e-01,8.438677e-01,8.436736e-01,8.434796e-01,8.432856e-01,8.430916e-01,8.428977e-01,8.427039e-01,8.425100e-01,8.423163e-01,8.421225e-01,8.419288e-01,8.417352e-01,8.415416e-01,8.413480e-01,8.411545e-01,8.409611e-01,8.407676e-01,8.405743e-01,8.403809e-01,8.401876e-01,8.399944e-01,8.398012e-01,8.396080e-01,8.394149e-01,8.392219e-01,8.390289e-01,8.388359e-01,8.386429e-01,8.384501e-01,8.382572e-01,8.380644e-01,8.378717e-01,8.376789e-01,8.374863e-01,8.372937e-01,8.371011e-01,8.369085e-01,8.367161e-01,8.365236e-01,8.363312e-01,8.361389e-01,8.359465e-01,8.357543e-01,8.355621e-01,8.353699e-01,8.351777e-01,8.349856e-01,8.347936e-01,8.346016e-01,8.344096e-01,8.342177e-01,8.340259e-01,8.338340e-01,8.336423e-01,8.334505e-01,8.332588e-01,8.330672e-01,8.328756e-01,8.326840e-01,8.324925e-01,8.323010e-01,8.321096e-01,8.319182e-01,8.317269e-01,8.315356e-01,8.313443e-01,8.311531e-01,8.309619e-01,8.307708e-01,8.305797e-01,8.303887e-01,8.301977e-01,8.300068e-01,8.298159e-01,8.296250e-01,8.294342e-01,8.292434e-01,8.290527e-01,8.288620e-01,8.286714e-01,8.284808e-01,8.282902e-01,8.280997e-01,8.279093e-01,8.277188e-01,8.275285e-01,8.273381e-01,8.271478e-01,8.269576e-01,8.267674e-01,8.265772e-01,8.263871e-01,8.261971e-01,8.260070e-01,8.258171e-01,8.256271e-01,8.254372e-01,8.252474e-01,8.250576e-01,8.248678e-01,8.246781e-01,8.244884e-01,8.242988e-01,8.241092e-01,8.239196e-01,8.237301e-01,8.235407e-01,8.233513e-01,8.231619e-01,8.229726e-01,8.227833e-01,8.225940e-01,8.224049e-01,8.222157e-01,8.220266e-01,8.218375e-01,8.216485e-01,8.214595e-01,8.212706e-01,8.210817e-01,8.208928e-01,8.207040e-01,8.205153e-01,8.203266e-01,8.201379e-01,8.199493e-01,8.197607e-01,8.195721e-01,8.193836e-01,8.191952e-01,8.190067e-01,8.188184e-01,8.186300e-01,8.184418e-01,8.182535e-01,8.180653e-01,8.178772e-01,8.176891e-01,8.175010e-01,8.173130e-01,8.171250e-01,8.169370e-01,8.167491e-01,8.165613e-01,8.163735e-01,8.161857e-01,8.159980e-01,8.158103e-01,8.156227e-01,8.154351e-01,8.152475e-01,8.150600e-01,8.148726e-01,8.146851e-01,8.144978e-01,8.143104e-01,8.141231e-01,8.139359e-01,8.137487e-01,8.135615e-01,8.133744e-01,8.131873e-01,8.130003e-01,8.128133e-01,8.126264e-01,8.124395e-01,8.122526e-01,8.120658e-01,8.118790e-01,8.116923e-01,8.115056e-01,8.113189e-01,8.111323e-01,8.109458e-01,8.107592e-01,8.105728e-01,8.103863e-01,8.102000e-01,8.100136e-01,8.098273e-01,8.096410e-01,8.094548e-01,8.092687e-01,8.090825e-01,8.088964e-01,8.087104e-01,8.085244e-01,8.083384e-01,8.081525e-01,8.079666e-01,8.077808e-01,8.075950e-01,8.074093e-01,8.072236e-01,8.070379e-01,8.068523e-01,8.066667e-01,8.064812e-01,8.062957e-01,8.061102e-01,8.059248e-01,8.057395e-01,8.055541e-01,8.053689e-01,8.051836e-01,8.049984e-01,8.048133e-01,8.046282e-01,8.044431e-01,8.042581e-01,8.040731e-01,8.038882e-01,8.037033e-01,8.035184e-01,8.033336e-01,8.031489e-01,8.029641e-01,8.027794e-01,8.025948e-01,8.024102e-01,8.022257e-01,8.020411e-01,8.018567e-01,8.016722e-01,8.014879e-01,8.013035e-01,8.011192e-01,8.009350e-01,8.007507e-01,8.005666e-01,8.003824e-01,8.001984e-01,8.000143e-01,7.998303e-01,7.996463e-01,7.994624e-01,7.992786e-01,7.990947e-01,7.989109e-01,7.987272e-01,7.985435e-01,7.983598e-01,7.981762e-01,7.979926e-01,7.978091e-01,7.976256e-01,7.974421e-01,7.972587e-01,7.970753e-01,7.968920e-01,7.967087e-01,7.965255e-01,7.963423e-01,7.961591e-01,7.959760e-01,7.957929e-01,7.956099e-01,7.954269e-01,7.952440e-01,7.950611e-01,7.948782e-01,7.946954e-01,7.945126e-01,7.943298e-01,7.941472e-01,7.939645e-01,7.937819e-01,7.935993e-01,7.934168e-01,7.932343e-01,7.930519e-01,7.928695e-01,7.926871e-01,7.925048e-01,7.923225e-01,7.921403e-01,7.919581e-01,7.917759e-01,7.915938e-01,7.914117e-01,7.912297e-01,7.910477e-01,7.908658e-01,7.906839e-01,7.905020e-01,7.903202e-01,7.901385e-01,7.899567e-01,7.897750e-01,7.895934e-01,7.894118e-01,7.892302e-01,7.890487e-01,7.888672e-01,7.886858e-01,7.885044e-01,7.883230e-01,7.881417e-01,7.879604e-01,7.877792e-01,7.875980e-01,7.874169e-01,7.872358e-01,7.870547e-01,7.868737e-01,7.866927e-01,7.865117e-01,7.863309e-01,7.861500e-01,7.859692e-01,7.857884e-01,7.856077e-01,7.854270e-01,7.852463e-01,7.850657e-01,7.848852e-01,7.847046e-01,7.845242e-01,7.843437e-01,7.841633e-01,7.839830e-01,7.838026e-01,7.836224e-01,7.834421e-01,7.832619e-01,7.830818e-01,7.829017e-01,7.827216e-01,7.825416e-01,7.823616e-01,7.821817e-01,7.820018e-01,7.818219e-01,7.816421e-01,7.814623e-01,7.812826e-01,7.811029e-01,7.809232e-01,7.807436e-01,7.805640e-01,7.803845e-01,7.802050e-01,7.800256e-01,7.798462e-01,7.796668e-01,7.794875e-01,7.793082e-01,7.791290e-01,7.789498e-01,7.787706e-01,7.785915e-01,7.784124e-01,7.782334e-01,7.780544e-01,7.778754e-01,7.776965e-01,7.775176e-01,7.773388e-01,7.771600e-01,7.769813e-01,7.768026e-01,7.766239e-01,7.764453e-01,7.762667e-01,7.760882e-01,7.759097e-01,7.757312e-01,7.755528e-01,7.753744e-01,7.751961e-01,7.750178e-01,7.748395e-01,7.746613e-01,7.744831e-01,7.743050e-01,7.741269e-01,7.739489e-01,7.737709e-01,7.735929e-01,7.734150e-01,7.732371e-01,7.730592e-01,7.728814e-01,7.727037e-01,7.725259e-01,7.723483e-01,7.721706e-01,7.719930e-01,7.718155e-01,7.716380e-01,7.714605e-01,7.712830e-01,7.711056e-01,7.709283e-01,7.707510e-01,7.705737e-01,7.703965e-01,7.702193e-01,7.700421e-01,7.698650e-01,7.696880e-01,7.695109e-01,7.693339e-01,7.691570e-01,7.689801e-01,7.688032e-01,7.686264e-01,7.684496e-01,7.682729e-01,7.680962e-01,7.679195e-01,7.677429e-01,7.675663e-01,7.673898e-01,7.672133e-01,7.670368e-01,7.668604e-01,7.666840e-01,7.665077e-01,7.663314e-01,7.661551e-01,7.659789e-01,7.658027e-01,7.656266e-01,7.654505e-01,7.652744e-01,7.650984e-01,7.649225e-01,7.647465e-01,7.645706e-01,7.643948e-01,7.642190e-01,7.640432e-01,7.638675e-01,7.636918e-01,7.635161e-01,7.633405e-01,7.631650e-01,7.629894e-01,7.628139e-01,7.626385e-01,7.624631e-01,7.622877e-01,7.621124e-01,7.619371e-01,7.617619e-01,7.615867e-01,7.614115e-01,7.612364e-01,7.610613e-01,7.608862e-01,7.607112e-01,7.605363e-01,7.603613e-01,7.601865e-01,7.600116e-01,7.598368e-01,7.596621e-01,7.594873e-01,7.593126e-01,7.591380e-01,7.589634e-01,7.587888e-01,7.586143e-01,7.584398e-01,7.582654e-01,7.580910e-01,7.579166e-01,7.577423e-01,7.575680e-01,7.573938e-01,7.572196e-01,7.570454e-01,7.568713e-01,7.566972e-01,7.565232e-01,7.563492e-01,7.561752e-01,7.560013e-01,7.558274e-01,7.556536e-01,7.554798e-01,7.553060e-01,7.551323e-01,7.549586e-01,7.547850e-01,7.546114e-01,7.544378e-01,7.542643e-01,7.540908e-01,7.539174e-01,7.537440e-01,7.535706e-01,7.533973e-01,7.532240e-01,7.530508e-01,7.528776e-01,7.527044e-01,7.525313e-01,7.523582e-01,7.521852e-01,7.520122e-01,7.518392e-01,7.516663e-01,7.514934e-01,7.513206e-01,7.511478e-01,7.509750e-01,7.508023e-01,7.506296e-01,7.504569e-01,7.502843e-01,7.501118e-01,7.499392e-01,7.497668e-01,7.495943e-01,7.494219e-01,7.492495e-01,7.490772e-01,7.489049e-01,7.487327e-01,7.485605e-01,7.483883e-01,7.482162e-01,7.480441e-01,7.478720e-01,7.477000e-01,7.475280e-01,7.473561e-01,7.471842e-01,7.470124e-01,7.468406e-01,7.466688e-01,7.464970e-01,7.463253e-01,7.461537e-01,7.459821e-01,7.458105e-01,7.456390e-01,7.454675e-01,7.452960e-01,7.451246e-01,7.449532e-01,7.447819e-01,7.446106e-01,7.444393e-01,7.442681e-01,7.440969e-01,7.439258e-01,7.437547e-01,7.435836e-01,7.434126e-01,7.432416e-01,7.430706e-01,7.428997e-01,7.427289e-01,7.425580e-01,7.423873e-01,7.422165e-01,7.420458e-01,7.418751e-01,7.417045e-01,7.415339e-01,7.413634e-01,7.411928e-01,7.410224e-01,7.408519e-01,7.406815e-01,7.405112e-01,7.403409e-01,7.401706e-01,7.400003e-01,7.398301e-01,7.396600e-01,7.394899e-01,7.393198e-01,7.391497e-01,7.389797e-01,7.388098e-01,7.386398e-01,7.384700e-01,7.383001e-01,7.381303e-01,7.379605e-01,7.377908e-01,7.376211e-01,7.374514e-01,7.372818e-01,7.371123e-01,7.369427e-01,7.367732e-01,7.366038e-01,7.364344e-01,7.362650e-01,7.360956e-01,7.359263e-01,7.357571e-01,7.355878e-01,7.354187e-01,7.352495e-01,7.350804e-01,7.349113e-01,7.347423e-01,7.345733e-01,7.344044e-01,7.342354e-01,7.340666e-01,7.338977e-01,7.337289e-01,7.335602e-01,7.333915e-01,7.332228e-01,7.330541e-01,7.328855e-01,7.327170e-01,7.325485e-01,7.323800e-01,7.322115e-01,7.320431e-01,7.318747e-01,7.317064e-01,7.315381e-01,7.313699e-01,7.312016e-01,7.310335e-01,7.308653e-01,7.306972e-01,7.305292e-01,7.303612e-01,7.301932e-01,7.300252e-01,7.298573e-01,7.296895e-01,7.295216e-01,7.293538e-01,7.291861e-01,7.290184e-01,7.288507e-01,7.286831e-01,7.285155e-01,7.283479e-01,7.281804e-01,7.280129e-01,7.278455e-01,7.276781e-01,7.275107e-01,7.273434e-01,7.271761e-01,7.270088e-01,7.268416e-01,7.266744e-01,7.265073e-01,7.263402e-01,7.261731e-01,7.260061e-01,7.258391e-01,7.256722e-01,7.255053e-01,7.253384e-01,7.251716e-01,7.250048e-01,7.248381e-01,7.246714e-01,7.245047e-01,7.243380e-01,7.241714e-01,7.240049e-01,7.238384e-01,7.236719e-01,7.235054e-01,7.233390e-01,7.231727e-01,7.230063e-01,7.228400e-01,7.226738e-01,7.225076e-01,7.223414e-01,7.221753e-01,7.220092e-01,7.218431e-01,7.216771e-01,7.215111e-01,7.213451e-01,7.211792e-01,7.210134e-01,7.208475e-01,7.206817e-01,7.205160e-01,7.203503e-01,7.201846e-01,7.200189e-01,7.198533e-01,7.196878e-01,7.195222e-01,7.193567e-01,7.191913e-01,7.190259e-01,7.188605e-01,7.186952e-01,7.185299e-01,7.183646e-01,7.181994e-01,7.180342e-01,7.178690e-01,7.177039e-01,7.175389e-01,7.173738e-01,7.172088e-01,7.170439e-01,7.168790e-01,7.167141e-01,7.165492e-01,7.163844e-01,7.162197e-01,7.160549e-01,7.158902e-01,7.157256e-01,7.155610e-01,7.153964e-01,7.152318e-01,7.150673e-01,7.149029e-01,7.147384e-01,7.145740e-01,7.144097e-01,7.142454e-01,7.140811e-01,7.139169e-01,7.137527e-01,7.135885e-01,7.134244e-01,7.132603e-01,7.130962e-01,7.129322e-01,7.127683e-01,7.126043e-01,7.124404e-01,7.122766e-01,7.121127e-01,7.119489e-01,7.117852e-01,7.116215e-01,7.114578e-01,7.112942e-01,7.111306e-01,7.109670e-01,7.108035e-01,7.106400e-01,7.104766e-01,7.103132e-01,7.101498e-01,7.099865e-01,7.098232e-01,7.096599e-01,7.094967e-01,7.093335e-01,7.091703e-01,7.090072e-01,7.088442e-01,7.086811e-01,7.085181e-01,7.083552e-01,7.081923e-01,7.080294e-01,7.078665e-01,7.077037e-01,7.075409e-01,7.073782e-01,7.072155e-01,7.070528e-01,7.068902e-01,7.067276e-01,7.065651e-01,7.064026e-01,7.062401e-01,7.060777e-01,7.059153e-01,7.057529e-01,7.055906e-01,7.054283e-01,7.052661e-01,7.051038e-01,7.049417e-01,7.047795e-01,7.046174e-01,7.044554e-01,7.042934e-01,7.041314e-01,7.039694e-01,7.038075e-01,7.036456e-01,7.034838e-01,7.033220e-01,7.031602e-01,7.029985e-01,7.028368e-01,7.026752e-01,7.025135e-01,7.023520e-01,7.021904e-01,7.020289e-01,7.018674e-01,7.017060e-01,7.015446e-01,7.013833e-01,7.012220e-01,7.010607e-01,7.008994e-01,7.007382e-01,7.005771e-01,7.004159e-01,7.002548e-01,7.000938e-01,6.999327e-01,6.997718e-01,6.996108e-01,6.994499e-01,6.992890e-01,6.991282e-01,6.989674e-01,6.988066e-01,6.986459e-01,6.984852e-01,6.983246e-01,6.981639e-01,6.980034e-01,6.978428e-01,6.976823e-01,6.975219e-01,6.973614e-01,6.972010e-01,6.970407e-01,6.968804e-01,6.967201e-01,6.965598e-01,6.963996e-01,6.962395e-01,6.960793e-01,6.959192e-01,6.957592e-01,6.955991e-01,6.954391e-01,6.952792e-01,6.951193e-01,6.949594e-01,6.947996e-01,6.946398e-01,6.944800e-01,6.943203e-01,6.941606e-01,6.940009e-01,6.938413e-01,6.936817e-01,6.935222e-01,6.933626e-01,6.932032e-01,6.930437e-01,6.928843e-01,6.927250e-01,6.925656e-01,6.924064e-01,6.922471e-01,6.920879e-01,6.919287e-01,6.917696e-01,6.916105e-01,6.914514e-01,6.912924e-01,6.911334e-01,6.909744e-01,6.908155e-01,6.906566e-01,6.904977e-01,6.903389e-01,6.901801e-01,6.900214e-01,6.898627e-01,6.897040e-01,6.895454e-01,6.893868e-01,6.892282e-01,6.890697e-01,6.889112e-01,6.887528e-01,6.885944e-01,6.884360e-01,6.882777e-01,6.881193e-01,6.879611e-01,6.878028e-01,6.876447e-01,6.874865e-01,6.873284e-01,6.871703e-01,6.870122e-01,6.868542e-01,6.866962e-01,6.865383e-01,6.863804e-01,6.862225e-01,6.860647e-01,6.859069e-01,6.857492e-01,6.855914e-01,6.854337e-01,6.852761e-01,6.851185e-01,6.849609e-01,6.848034e-01,6.846459e-01,6.844884e-01,6.843310e-01,6.841736e-01,6.840162e-01,6.838589e-01,6.837016e-01,6.835443e-01,6.833871e-01,6.832299e-01,6.830728e-01,6.829157e-01,6.827586e-01,6.826016e-01,6.824446e-01,6.822876e-01,6.821307e-01,6.819738e-01,6.818170e-01,6.816601e-01,6.815034e-01,6.813466e-01,6.811899e-01,6.810332e-01,6.808766e-01,6.807200e-01,6.805634e-01,6.804069e-01,6.802504e-01,6.800939e-01,6.799375e-01,6.797811e-01,6.796248e-01,6.794685e-01,6.793122e-01,6.791560e-01,6.789997e-01,6.788436e-01,6.786874e-01,6.785313e-01,6.783753e-01,6.782193e-01,6.780633e-01,6.779073e-01,6.777514e-01,6.775955e-01,6.774397e-01,6.772839e-01,6.771281e-01,6.769723e-01,6.768166e-01,6.766610e-01,6.765053e-01,6.763497e-01,6.761942e-01,6.760387e-01,6.758832e-01,6.757277e-01,6.755723e-01,6.754169e-01,6.752616e-01,6.751063e-01,6.749510e-01,6.747957e-01,6.746405e-01,6.744854e-01,6.743302e-01,6.741751e-01,6.740201e-01,6.738651e-01,6.737101e-01,6.735551e-01,6.734002e-01,6.732453e-01,6.730905e-01,6.729357e-01,6.727809e-01,6.726261e-01,6.724714e-01,6.723168e-01,6.721621e-01,6.720075e-01,6.718530e-01,6.716985e-01,6.715440e-01,6.713895e-01,6.712351e-01,6.710807e-01,6.709264e-01,6.707720e-01,6.706178e-01,6.704635e-01,6.703093e-01,6.701551e-01,6.700010e-01,6.698469e-01,6.696928e-01,6.695388e-01,6.693848e-01,6.692309e-01,6.690769e-01,6.689231e-01,6.687692e-01,6.686154e-01,6.684616e-01,6.683079e-01,6.681541e-01,6.680005e-01,6.678468e-01,6.676932e-01,6.675397e-01,6.673861e-01,6.672326e-01,6.670792e-01,6.669257e-01,6.667723e-01,6.666190e-01,6.664657e-01,6.663124e-01,6.661591e-01,6.660059e-01,6.658527e-01,6.656996e-01,6.655465e-01,6.653934e-01,6.652403e-01,6.650873e-01,6.649344e-01,6.647814e-01,6.646285e-01,6.644757e-01,6.643228e-01,6.641701e-01,6.640173e-01,6.638646e-01,6.637119e-01,6.635592e-01,6.634066e-01,6.632540e-01,6.631015e-01,6.629490e-01,6.627965e-01,6.626440e-01,6.624916e-01,6.623393e-01,6.621869e-01,6.620346e-01,6.618823e-01,6.617301e-01,6.615779e-01,6.614258e-01,6.612736e-01,6.611215e-01,6.609695e-01,6.608175e-01,6.606655e-01,6.605135e-01,6.603616e-01,6.602097e-01,6.600579e-01,6.599061e-01,6.597543e-01,6.596025e-01,6.594508e-01,6.592991e-01,6.591475e-01,6.589959e-01,6.588443e-01,6.586928e-01,6.585413e-01,6.583898e-01,6.582384e-01,6.580870e-01,6.579357e-01,6.577843e-01,6.576330e-01,6.574818e-01,6.573306e-01,6.571794e-01,6.570282e-01,6.568771e-01,6.567260e-01,6.565750e-01,6.564240e-01,6.562730e-01,6.561220e-01,6.559711e-01,6.558203e-01,6.556694e-01,6.555186e-01,6.553679e-01,6.552171e-01,6.550664e-01,6.549158e-01,6.547651e-01,6.546145e-01,6.544640e-01,6.543134e-01,6.541629e-01,6.540125e-01,6.538621e-01,6.537117e-01,6.535613e-01,6.534110e-01,6.532607e-01,6.531105e-01,6.529603e-01,6.528101e-01,6.526599e-01,6.525098e-01,6.523597e-01,6.522097e-01,6.520597e-01,6.519097e-01,6.517598e-01,6.516099e-01,6.514600e-01,6.513102e-01,6.511604e-01,6.510106e-01,6.508609e-01,6.507112e-01,6.505615e-01,6.504119e-01,6.502623e-01,6.501127e-01,6.499632e-01,6.498137e-01,6.496642e-01,6.495148e-01,6.493654e-01,6.492161e-01,6.490668e-01,6.489175e-01,6.487682e-01,6.486190e-01,6.484698e-01,6.483207e-01,6.481716e-01,6.480225e-01,6.478734e-01,6.477244e-01,6.475754e-01,6.474265e-01,6.472776e-01,6.471287e-01,6.469799e-01,6.468311e-01,6.466823e-01,6.465336e-01,6.463849e-01,6.462362e-01,6.460876e-01,6.459390e-01,6.457904e-01,6.456419e-01,6.454934e-01,6.453449e-01,6.451965e-01,6.450481e-01,6.448997e-01,6.447514e-01,6.446031e-01,6.444548e-01,6.443066e-01,6.441584e-01,6.440103e-01,6.438621e-01,6.437141e-01,6.435660e-01,6.434180e-01,6.432700e-01,6.431220e-01,6.429741e-01,6.428262e-01,6.426784e-01,6.425306e-01,6.423828e-01,6.422350e-01,6.420873e-01,6.419397e-01,6.417920e-01,6.416444e-01,6.414968e-01,6.413493e-01,6.412018e-01,6.410543e-01,6.409068e-01,6.407594e-01,6.406121e-01,6.404647e-01,6.403174e-01,6.401701e-01,6.400229e-01,6.398757e-01,6.397285e-01,6.395814e-01,6.394343e-01,6.392872e-01,6.391402e-01,6.389932e-01,6.388462e-01,6.386993e-01,6.385524e-01,6.384055e-01,6.382587e-01,6.381119e-01,6.379651e-01,6.378184e-01,6.376717e-01,6.375250e-01,6.373784e-01,6.372318e-01,6.370852e-01,6.369387e-01,6.367922e-01,6.366457e-01,6.364993e-01,6.363529e-01,6.362065e-01,6.360602e-01,6.359139e-01,6.357677e-01,6.356214e-01,6.354752e-01,6.353291e-01,6.351830e-01,6.350369e-01,6.348908e-01,6.347448e-01,6.345988e-01,6.344528e-01,6.343069e-01,6.341610e-01,6.340152e-01,6.338693e-01,6.337236e-01,6.335778e-01,6.334321e-01,6.332864e-01,6.331407e-01,6.329951e-01,6.328495e-01,6.327040e-01,6.325584e-01,6.324129e-01,6.322675e-01,6.321221e-01,6.319767e-01,6.318313e-01,6.316860e-01,6.315407e-01,6.313955e-01,6.312502e-01,6.311051e-01,6.309599e-01,6.308148e-01,6.306697e-01,6.305246e-01,6.303796e-01,6.302346e-01,6.300897e-01,6.299448e-01,6.297999e-01,6.296550e-01,6.295102e-01,6.293654e-01,6.292207e-01,6.290759e-01,6.289312e-01,6.287866e-01,6.286420e-01,6.284974e-01,6.283528e-01,6.282083e-01,6.280638e-01,6.279194e-01,6.277749e-01,6.276306e-01,6.274862e-01,6.273419e-01,6.271976e-01,6.270533e-01,6.269091e-01,6.267649e-01,6.266208e-01,6.264766e-01,6.263326e-01,6.261885e-01,6.260445e-01,6.259005e-01,6.257565e-01,6.256126e-01,6.254687e-01,6.253249e-01,6.251810e-01,6.250372e-01,6.248935e-01,6.247498e-01,6.246061e-01,6.244624e-01,6.243188e-01,6.241752e-01,6.240316e-01,6.238881e-01,6.237446e-01,6.236011e-01,6.234577e-01,6.233143e-01,6.231710e-01,6.230276e-01,6.228843e-01,6.227411e-01,6.225978e-01,6.224546e-01,6.223115e-01,6.221683e-01,6.220252e-01,6.218822e-01,6.217391e-01,6.215961e-01,6.214532e-01,6.213102e-01,6.211673e-01,6.210245e-01,6.208816e-01,6.207388e-01,6.205961e-01,6.204533e-01,6.203106e-01,6.201680e-01,6.200253e-01,6.198827e-01,6.197401e-01,6.195976e-01,6.194551e-01,6.193126e-01,6.191702e-01,6.190278e-01,6.188854e-01,6.187430e-01,6.186007e-01,6.184585e-01,6.183162e-01,6.181740e-01,6.180318e-01,6.178897e-01,6.177476e-01,6.176055e-01,6.174634e-01,6.173214e-01,6.171794e-01,6.170375e-01,6.168956e-01,6.167537e-01,6.166118e-01,6.164700e-01,6.163282e-01,6.161864e-01,6.160447e-01,6.159030e-01,6.157614e-01,6.156198e-01,6.154782e-01,6.153366e-01,6.151951e-01,6.150536e-01,6.149121e-01,6.147707e-01,6.146293e-01,6.144879e-01,6.143466e-01,6.142053e-01,6.140640e-01,6.139228e-01,6.137816e-01,6.136404e-01,6.134993e-01,6.133582e-01,6.132171e-01,6.130761e-01,6.129351e-01,6.127941e-01,6.126531e-01,6.125122e-01,6.123713e-01,6.122305e-01,6.120897e-01,6.119489e-01,6.118082e-01,6.116674e-01,6.115268e-01,6.113861e-01,6.112455e-01,6.111049e-01,6.109644e-01,6.108238e-01,6.106833e-01,6.105429e-01,6.104025e-01,6.102621e-01,6.101217e-01,6.099814e-01,6.098411e-01,6.097008e-01,6.095606e-01,6.094204e-01,6.092802e-01,6.091401e-01,6.090000e-01,6.088599e-01,6.087199e-01,6.085799e-01,6.084399e-01,6.083000e-01,6.081600e-01,6.080202e-01,6.078803e-01,6.077405e-01,6.076007e-01,6.074610e-01,6.073213e-01,6.071816e-01,6.070419e-01,6.069023e-01,6.067627e-01,6.066232e-01,6.064836e-01,6.063442e-01,6.062047e-01,6.060653e-01,6.059259e-01,6.057865e-01,6.056472e-01,6.055079e-01,6.053686e-01,6.052294e-01,6.050902e-01,6.049510e-01,6.048119e-01,6.046728e-01,6.045337e-01,6.043946e-01,6.042556e-01,6.041167e-01,6.039777e-01,6.038388e-01,6.036999e-01,6.035611e-01,6.034222e-01,6.032835e-01,6.031447e-01,6.030060e-01,6.028673e-01,6.027286e-01,6.025900e-01,6.024514e-01,6.023128e-01,6.021743e-01,6.020358e-01,6.018973e-01,6.017589e-01,6.016205e-01,6.014821e-01,6.013438e-01,6.012055e-01,6.010672e-01,6.009290e-01,6.007907e-01,6.006526e-01,6.005144e-01,6.003763e-01,6.002382e-01,6.001001e-01,5.999621e-01,5.998241e-01,5.996862e-01,5.995482e-01,5.994103e-01,5.992725e-01,5.991347e-01,5.989969e-01,5.988591e-01,5.987213e-01,5.985836e-01,5.984460e-01,5.983083e-01,5.981707e-01,5.980331e-01,5.978956e-01,5.977581e-01,5.976206e-01,5.974831e-01,5.973457e-01,5.972083e-01,5.970710e-01,5.969336e-01,5.967963e-01,5.966591e-01,5.965218e-01,5.963846e-01,5.962475e-01,5.961103e-01,5.959732e-01,5.958362e-01,5.956991e-01,5.955621e-01,5.954251e-01,5.952882e-01,5.951513e-01,5.950144e-01,5.948775e-01,5.947407e-01,5.946039e-01,5.944672e-01,5.943304e-01,5.941937e-01,5.940571e-01,5.939204e-01,5.937838e-01,5.936473e-01,5.935107e-01,5.933742e-01,5.932377e-01,5.931013e-01,5.929649e-01,5.928285e-01,5.926921e-01,5.925558e-01,5.924195e-01,5.922833e-01,5.921471e-01,5.920109e-01,5.918747e-01,5.917386e-01,5.916025e-01,5.914664e-01,5.913304e-01,5.911944e-01,5.910584e-01,5.909224e-01,5.907865e-01,5.906506e-01,5.905148e-01,5.903790e-01,5.902432e-01,5.901074e-01,5.899717e-01,5.898360e-01,5.897004e-01,5.895647e-01,5.894291e-01,5.892936e-01,5.891580e-01,5.890225e-01,5.888870e-01,5.887516e-01,5.886162e-01,5.884808e-01,5.883455e-01,5.882101e-01,5.880748e-01,5.879396e-01,5.878044e-01,5.876692e-01,5.875340e-01,5.873989e-01,5.872638e-01,5.871287e-01,5.869937e-01,5.868586e-01,5.867237e-01,5.865887e-01,5.864538e-01,5.863189e-01,5.861841e-01,5.860492e-01,5.859145e-01,5.857797e-01,5.856450e-01,5.855103e-01,5.853756e-01,5.852410e-01,5.851064e-01,5.849718e-01,5.848372e-01,5.847027e-01,5.845682e-01,5.844338e-01,5.842994e-01,5.841650e-01,5.840306e-01,5.838963e-01,5.837620e-01,5.836277e-01,5.834935e-01,5.833593e-01,5.832251e-01,5.830910e-01,5.829569e-01,5.828228e-01,5.826887e-01,5.825547e-01,5.824207e-01,5.822868e-01,5.821529e-01,5.820190e-01,5.818851e-01,5.817513e-01,5.816175e-01,5.814837e-01,5.813500e-01,5.812162e-01,5.810826e-01,5.809489e-01,5.808153e-01,5.806817e-01,5.805481e-01,5.804146e-01,5.802811e-01,5.801477e-01,5.800142e-01,5.798808e-01,5.797475e-01,5.796141e-01,5.794808e-01,5.793475e-01,5.792143e-01,5.790811e-01,5.789479e-01,5.788147e-01,5.786816e-01,5.785485e-01,5.784154e-01,5.782824e-01,5.781494e-01,5.780164e-01,5.778835e-01,5.777505e-01,5.776177e-01,5.774848e-01,5.773520e-01,5.772192e-01,5.770864e-01,5.769537e-01,5.768210e-01,5.766883e-01,5.765557e-01,5.764231e-01,5.762905e-01,5.761580e-01,5.760254e-01,5.758930e-01,5.757605e-01,5.756281e-01,5.754957e-01,5.753633e-01,5.752310e-01,5.750987e-01,5.749664e-01,5.748342e-01,5.747020e-01,5.745698e-01,5.744376e-01,5.743055e-01,5.741734e-01,5.740414e-01,5.739093e-01,5.737773e-01,5.736454e-01,5.735134e-01,5.733815e-01,5.732496e-01,5.731178e-01,5.729860e-01,5.728542e-01,5.727224e-01,5.725907e-01,5.724590e-01,5.723273e-01,5.721957e-01,5.720641e-01,5.719325e-01,5.718010e-01,5.716695e-01,5.715380e-01,5.714065e-01,5.712751e-01,5.711437e-01,5.710123e-01,5.708810e-01,5.707497e-01,5.706184e-01,5.704872e-01,5.703560e-01,5.702248e-01,5.700937e-01,5.699625e-01,5.698314e-01,5.697004e-01,5.695693e-01,5.694383e-01,5.693074e-01,5.691764e-01,5.690455e-01,5.689146e-01,5.687838e-01,5.686530e-01,5.685222e-01,5.683914e-01,5.682607e-01,5.681300e-01,5.679993e-01,5.678687e-01,5.677381e-01,5.676075e-01,5.674769e-01,5.673464e-01,5.672159e-01,5.670855e-01,5.669550e-01,5.668246e-01,5.666943e-01,5.665639e-01,5.664336e-01,5.663033e-01,5.661731e-01,5.660429e-01,5.659127e-01,5.657825e-01,5.656524e-01,5.655223e-01,5.653922e-01,5.652622e-01,5.651322e-01,5.650022e-01,5.648722e-01,5.647423e-01,5.646124e-01,5.644826e-01,5.643527e-01,5.642229e-01,5.640932e-01,5.639634e-01,5.638337e-01,5.637040e-01,5.635744e-01,5.634448e-01,5.633152e-01,5.631856e-01,5.630561e-01,5.629266e-01,5.627971e-01,5.626677e-01,5.625382e-01,5.624089e-01,5.622795e-01,5.621502e-01,5.620209e-01,5.618916e-01,5.617624e-01,5.616332e-01,5.615040e-01,5.613749e-01,5.612457e-01,5.611167e-01,5.609876e-01,5.608586e-01,5.607296e-01,5.606006e-01,5.604717e-01,5.603428e-01,5.602139e-01,5.600850e-01,5.599562e-01,5.598274e-01,5.596987e-01,5.595699e-01,5.594412e-01,5.593126e-01,5.591839e-01,5.590553e-01,5.589267e-01,5.587982e-01,5.586696e-01,5.585412e-01,5.584127e-01,5.582843e-01,5.581558e-01,5.580275e-01,5.578991e-01,5.577708e-01,5.576425e-01,5.575143e-01,5.573860e-01,5.572578e-01,5.571297e-01,5.570015e-01,5.568734e-01,5.567453e-01,5.566173e-01,5.564893e-01,5.563613e-01,5.562333e-01,5.561054e-01,5.559775e-01,5.558496e-01,5.557217e-01,5.555939e-01,5.554661e-01,5.553384e-01,5.552107e-01,5.550830e-01,5.549553e-01,5.548277e-01,5.547000e-01,5.545725e-01,5.544449e-01,5.543174e-01,5.541899e-01,5.540624e-01,5.539350e-01,5.538076e-01,5.536802e-01,5.535529e-01,5.534256e-01,5.532983e-01,5.531710e-01,5.530438e-01,5.529166e-01,5.527894e-01,5.526623e-01,5.525352e-01,5.524081e-01,5.522810e-01,5.521540e-01,5.520270e-01,5.519000e-01,5.517731e-01,5.516462e-01,5.515193e-01,5.513925e-01,5.512656e-01,5.511388e-01,5.510121e-01,5.508853e-01,5.507586e-01,5.506320e-01,5.505053e-01,5.503787e-01,5.502521e-01,5.501256e-01,5.499990e-01,5.498725e-01,5.497461e-01,5.496196e-01,5.494932e-01,5.493668e-01,5.492405e-01,5.491141e-01,5.489879e-01,5.488616e-01,5.487353e-01,5.486091e-01,5.484830e-01,5.483568e-01,5.482307e-01,5.481046e-01,5.479785e-01,5.478525e-01,5.477265e-01,5.476005e-01,5.474746e-01,5.473486e-01,5.472228e-01,5.470969e-01,5.469711e-01,5.468453e-01,5.467195e-01,5.465937e-01,5.464680e-01,5.463423e-01,5.462167e-01,5.460910e-01,5.459654e-01,5.458399e-01,5.457143e-01,5.455888e-01,5.454633e-01,5.453379e-01,5.452124e-01,5.450870e-01,5.449617e-01,5.448363e-01,5.447110e-01,5.445857e-01,5.444605e-01,5.443353e-01,5.442101e-01,5.440849e-01,5.439597e-01,5.438346e-01,5.437096e-01,5.435845e-01,5.434595e-01,5.433345e-01,5.432095e-01,5.430846e-01,5.429597e-01,5.428348e-01,5.427099e-01,5.425851e-01,5.424603e-01,5.423356e-01,5.422108e-01,5.420861e-01,5.419614e-01,5.418368e-01,5.417122e-01,5.415876e-01,5.414630e-01,5.413385e-01,5.412140e-01,5.410895e-01,5.409650e-01,5.408406e-01,5.407162e-01,5.405918e-01,5.404675e-01,5.403432e-01,5.402189e-01,5.400947e-01,5.399704e-01,5.398463e-01,5.397221e-01,5.395980e-01,5.394738e-01,5.393498e-01,5.392257e-01,5.391017e-01,5.389777e-01,5.388537e-01,5.387298e-01,5.386059e-01,5.384820e-01,5.383582e-01,5.382343e-01,5.381105e-01,5.379868e-01,5.378630e-01,5.377393e-01,5.376157e-01,5.374920e-01,5.373684e-01,5.372448e-01,5.371212e-01,5.369977e-01,5.368742e-01,5.367507e-01,5.366272e-01,5.365038e-01,5.363804e-01,5.362570e-01,5.361337e-01,5.360104e-01,5.358871e-01,5.357639e-01,5.356406e-01,5.355174e-01,5.353943e-01,5.352711e-01,5.351480e-01,5.350249e-01,5.349019e-01,5.347789e-01,5.346559e-01,5.345329e-01,5.344099e-01,5.342870e-01,5.341641e-01,5.340413e-01,5.339185e-01,5.337956e-01,5.336729e-01,5.335501e-01,5.334274e-01,5.333047e-01,5.331821e-01,5.330594e-01,5.329368e-01,5.328143e-01,5.326917e-01,5.325692e-01,5.324467e-01,5.323242e-01,5.322018e-01,5.320794e-01,5.319570e-01,5.318347e-01,5.317123e-01,5.315901e-01,5.314678e-01,5.313455e-01,5.312233e-01,5.311012e-01,5.309790e-01,5.308569e-01,5.307348e-01,5.306127e-01,5.304907e-01,5.303687e-01,5.302467e-01,5.301247e-01,5.300028e-01,5.298809e-01,5.297590e-01,5.296372e-01,5.295154e-01,5.293936e-01,5.292718e-01,5.291501e-01,5.290284e-01,5.289067e-01,5.287850e-01,5.286634e-01,5.285418e-01,5.284203e-01,5.282987e-01,5.281772e-01,5.280557e-01,5.279343e-01,5.278129e-01,5.276915e-01,5.275701e-01,5.274488e-01,5.273274e-01,5.272062e-01,5.270849e-01,5.269637e-01,5.268425e-01,5.267213e-01,5.266001e-01,5.264790e-01,5.263579e-01,5.262369e-01,5.261158e-01,5.259948e-01,5.258739e-01,5.257529e-01,5.256320e-01,5.255111e-01,5.253902e-01,5.252694e-01,5.251486e-01,5.250278e-01,5.249070e-01,5.247863e-01,5.246656e-01,5.245449e-01,5.244243e-01,5.243037e-01,5.241831e-01,5.240625e-01,5.239420e-01,5.238215e-01,5.237010e-01,5.235805e-01,5.234601e-01,5.233397e-01,5.232194e-01,5.230990e-01,5.229787e-01,5.228584e-01,5.227382e-01,5.226179e-01,5.224977e-01,5.223775e-01,5.222574e-01,5.221373e-01,5.220172e-01,5.218971e-01,5.217771e-01,5.216571e-01,5.215371e-01,5.214171e-01,5.212972e-01,5.211773e-01,5.210575e-01,5.209376e-01,5.208178e-01,5.206980e-01,5.205782e-01,5.204585e-01,5.203388e-01,5.202191e-01,5.200995e-01,5.199799e-01,5.198603e-01,5.197407e-01,5.196212e-01,5.195016e-01,5.193822e-01,5.192627e-01,5.191433e-01,5.190239e-01,5.189045e-01,5.187851e-01,5.186658e-01,5.185465e-01,5.184273e-01,5.183080e-01,5.181888e-01,5.180696e-01,5.179505e-01,5.178313e-01,5.177122e-01,5.175932e-01,5.174741e-01,5.173551e-01,5.172361e-01,5.171171e-01,5.169982e-01,5.168793e-01,5.167604e-01,5.166416e-01,5.165227e-01,5.164039e-01,5.162852e-01,5.161664e-01,5.160477e-01,5.159290e-01,5.158103e-01,5.156917e-01,5.155731e-01,5.154545e-01,5.153360e-01,5.152174e-01,5.150989e-01,5.149805e-01,5.148620e-01,5.147436e-01,5.146252e-01,5.145068e-01,5.143885e-01,5.142702e-01,5.141519e-01,5.140337e-01,5.139154e-01,5.137972e-01,5.136791e-01,5.135609e-01,5.134428e-01,5.133247e-01,5.132066e-01,5.130886e-01,5.129706e-01,5.128526e-01,5.127346e-01,5.126167e-01,5.124988e-01,5.123809e-01,5.122631e-01,5.121453e-01,5.120275e-01,5.119097e-01,5.117920e-01,5.116743e-01,5.115566e-01,5.114389e-01,5.113213e-01,5.112037e-01,5.110861e-01,5.109686e-01,5.108510e-01,5.107335e-01,5.106161e-01,5.104986e-01,5.103812e-01,5.102638e-01,5.101465e-01,5.100291e-01,5.099118e-01,5.097945e-01,5.096773e-01,5.095601e-01,5.094429e-01,5.093257e-01,5.092086e-01,5.090914e-01,5.089743e-01,5.088573e-01,5.087402e-01,5.086232e-01,5.085062e-01,5.083893e-01,5.082724e-01,5.081555e-01,5.080386e-01,5.079217e-01,5.078049e-01,5.076881e-01,5.075714e-01,5.074546e-01,5.073379e-01,5.072212e-01,5.071045e-01,5.069879e-01,5.068713e-01,5.067547e-01,5.066382e-01,5.065216e-01,5.064051e-01,5.062887e-01,5.061722e-01,5.060558e-01,5.059394e-01,5.058230e-01,5.057067e-01,5.055904e-01,5.054741e-01,5.053578e-01,5.052416e-01,5.051254e-01,5.050092e-01,5.048931e-01,5.047770e-01,5.046609e-01,5.045448e-01,5.044287e-01,5.043127e-01,5.041967e-01,5.040808e-01,5.039648e-01,5.038489e-01,5.037330e-01,5.036172e-01,5.035013e-01,5.033855e-01,5.032698e-01,5.031540e-01,5.030383e-01,5.029226e-01,5.028069e-01,5.026913e-01,5.025756e-01,5.024600e-01,5.023445e-01,5.022289e-01,5.021134e-01,5.019979e-01,5.018825e-01,5.017671e-01,5.016516e-01,5.015363e-01,5.014209e-01,5.013056e-01,5.011903e-01,5.010750e-01,5.009598e-01,5.008445e-01,5.007293e-01,5.006142e-01,5.004990e-01,5.003839e-01,5.002688e-01,5.001538e-01,5.000387e-01,4.999237e-01,4.998087e-01,4.996938e-01,4.995789e-01,4.994640e-01,4.993491e-01,4.992342e-01,4.991194e-01,4.990046e-01,4.988898e-01,4.987751e-01,4.986604e-01,4.985457e-01,4.984310e-01,4.983164e-01,4.982018e-01,4.980872e-01,4.979726e-01,4.978581e-01,4.977436e-01,4.976291e-01,4.975146e-01,4.974002e-01,4.972858e-01,4.971714e-01,4.970571e-01,4.969428e-01,4.968285e-01,4.967142e-01,4.966000e-01,4.964857e-01,4.963715e-01,4.962574e-01,4.961432e-01,4.960291e-01,4.959150e-01,4.958010e-01,4.956869e-01,4.955729e-01,4.954590e-01,4.953450e-01,4.952311e-01,4.951172e-01,4.950033e-01,4.948894e-01,4.947756e-01,4.946618e-01,4.945480e-01,4.944343e-01,4.943206e-01,4.942069e-01,4.940932e-01,4.939796e-01,4.938660e-01,4.937524e-01,4.936388e-01,4.935253e-01,4.934118e-01,4.932983e-01,4.931848e-01,4.930714e-01,4.929580e-01,4.928446e-01,4.927312e-01,4.926179e-01,4.925046e-01,4.923913e-01,4.922781e-01,4.921649e-01,4.920517e-01,4.919385e-01,4.918253e-01,4.917122e-01,4.915991e-01,4.914861e-01,4.913730e-01,4.912600e-01,4.911470e-01,4.910341e-01,4.909211e-01,4.908082e-01,4.906953e-01,4.905825e-01,4.904696e-01,4.903568e-01,4.902440e-01,4.901313e-01,4.900185e-01,4.899058e-01,4.897932e-01,4.896805e-01,4.895679e-01,4.894553e-01,4.893427e-01,4.892302e-01,4.891176e-01,4.890051e-01,4.888927e-01,4.887802e-01,4.886678e-01,4.885554e-01,4.884430e-01,4.883307e-01,4.882184e-01,4.881061e-01,4.879938e-01,4.878816e-01,4.877694e-01,4.876572e-01,4.875450e-01,4.874329e-01,4.873208e-01,4.872087e-01,4.870966e-01,4.869846e-01,4.868726e-01,4.867606e-01,4.866487e-01,4.865367e-01,4.864248e-01,4.863130e-01,4.862011e-01,4.860893e-01,4.859775e-01,4.858657e-01,4.857540e-01,4.856422e-01,4.855305e-01,4.854189e-01,4.853072e-01,4.851956e-01,4.850840e-01,4.849724e-01,4.848609e-01,4.847494e-01,4.846379e-01,4.845264e-01,4.844150e-01,4.843036e-01,4.841922e-01,4.840808e-01,4.839695e-01,4.838582e-01,4.837469e-01,4.836356e-01,4.835244e-01,4.834132e-01,4.833020e-01,4.831908e-01,4.830797e-01,4.829686e-01,4.828575e-01,4.827464e-01,4.826354e-01,4.825244e-01,4.824134e-01,4.823025e-01,4.821915e-01,4.820806e-01,4.819697e-01,4.818589e-01,4.817481e-01,4.816373e-01,4.815265e-01,4.814157e-01,4.813050e-01,4.811943e-01,4.810836e-01,4.809730e-01,4.808624e-01,4.807518e-01,4.806412e-01,4.805306e-01,4.804201e-01,4.803096e-01,4.801992e-01,4.800887e-01,4.799783e-01,4.798679e-01,4.797575e-01,4.796472e-01,4.795369e-01,4.794266e-01,4.793163e-01,4.792061e-01,4.790958e-01,4.789856e-01,4.788755e-01,4.787653e-01,4.786552e-01,4.785451e-01,4.784351e-01,4.783250e-01,4.782150e-01,4.781050e-01,4.779951e-01,4.778851e-01,4.777752e-01,4.776653e-01,4.775555e-01,4.774456e-01,4.773358e-01,4.772260e-01,4.771163e-01,4.770065e-01,4.768968e-01,4.767871e-01,4.766775e-01,4.765678e-01,4.764582e-01,4.763486e-01,4.762391e-01,4.761295e-01,4.760200e-01,4.759105e-01,4.758011e-01,4.756916e-01,4.755822e-01,4.754728e-01,4.753635e-01,4.752542e-01,4.751448e-01,4.750356e-01,4.749263e-01,4.748171e-01,4.747079e-01,4.745987e-01,4.744895e-01,4.743804e-01,4.742713e-01,4.741622e-01,4.740531e-01,4.739441e-01,4.738351e-01,4.737261e-01,4.736172e-01,4.735082e-01,4.733993e-01,4.732904e-01,4.731816e-01,4.730728e-01,4.729640e-01,4.728552e-01,4.727464e-01,4.726377e-01,4.725290e-01,4.724203e-01,4.723116e-01,4.722030e-01,4.720944e-01,4.719858e-01,4.718773e-01,4.717687e-01,4.716602e-01,4.715517e-01,4.714433e-01,4.713348e-01,4.712264e-01,4.711181e-01,4.710097e-01,4.709014e-01,4.707931e-01,4.706848e-01,4.705765e-01,4.704683e-01,4.703601e-01,4.702519e-01,4.701437e-01,4.700356e-01,4.699275e-01,4.698194e-01,4.697114e-01,4.696033e-01,4.694953e-01,4.693873e-01,4.692794e-01,4.691714e-01,4.690635e-01,4.689556e-01,4.688478e-01,4.687400e-01,4.686321e-01,4.685244e-01,4.684166e-01,4.683089e-01,4.682011e-01,4.680935e-01,4.679858e-01,4.678782e-01,4.677706e-01,4.676630e-01,4.675554e-01,4.674479e-01,4.673404e-01,4.672329e-01,4.671254e-01,4.670180e-01,4.669105e-01,4.668032e-01,4.666958e-01,4.665885e-01,4.664811e-01,4.663738e-01,4.662666e-01,4.661593e-01,4.660521e-01,4.659449e-01,4.658378e-01,4.657306e-01,4.656235e-01,4.655164e-01,4.654093e-01,4.653023e-01,4.651953e-01,4.650883e-01,4.649813e-01,4.648744e-01,4.647674e-01,4.646605e-01,4.645537e-01,4.644468e-01,4.643400e-01,4.642332e-01,4.641264e-01,4.640197e-01,4.639130e-01,4.638063e-01,4.636996e-01,4.635929e-01,4.634863e-01,4.633797e-01,4.632731e-01,4.631666e-01,4.630600e-01,4.629535e-01,4.628471e-01,4.627406e-01,4.626342e-01,4.625278e-01,4.624214e-01,4.623150e-01,4.622087e-01,4.621024e-01,4.619961e-01,4.618899e-01,4.617836e-01,4.616774e-01,4.615712e-01,4.614651e-01,4.613589e-01,4.612528e-01,4.611467e-01,4.610407e-01,4.609346e-01,4.608286e-01,4.607226e-01,4.606166e-01,4.605107e-01,4.604048e-01,4.602989e-01,4.601930e-01,4.600872e-01,4.599814e-01,4.598756e-01,4.597698e-01,4.596640e-01,4.595583e-01,4.594526e-01,4.593470e-01,4.592413e-01,4.591357e-01,4.590301e-01,4.589245e-01,4.588189e-01,4.587134e-01,4.586079e-01,4.585024e-01,4.583970e-01,4.582915e-01,4.581861e-01,4.580808e-01,4.579754e-01,4.578701e-01,4.577648e-01,4.576595e-01,4.575542e-01,4.574490e-01,4.573438e-01,4.572386e-01,4.571334e-01,4.570283e-01,4.569231e-01,4.568181e-01,4.567130e-01,4.566079e-01,4.565029e-01,4.563979e-01,4.562930e-01,4.561880e-01,4.560831e-01,4.559782e-01,4.558733e-01,4.557685e-01,4.556636e-01,4.555588e-01,4.554540e-01,4.553493e-01,4.552446e-01,4.551399e-01,4.550352e-01,4.549305e-01,4.548259e-01,4.547213e-01,4.546167e-01,4.545121e-01,4.544076e-01,4.543031e-01,4.541986e-01,4.540941e-01,4.539897e-01,4.538853e-01,4.537809e-01,4.536765e-01,4.535722e-01,4.534678e-01,4.533635e-01,4.532593e-01,4.531550e-01,4.530508e-01,4.529466e-01,4.528424e-01,4.527383e-01,4.526341e-01,4.525300e-01,4.524259e-01,4.523219e-01,4.522178e-01,4.521138e-01,4.520098e-01,4.519059e-01,4.518019e-01,4.516980e-01,4.515941e-01,4.514903e-01,4.513864e-01,4.512826e-01,4.511788e-01,4.510750e-01,4.509713e-01,4.508676e-01,4.507639e-01,4.506602e-01,4.505565e-01,4.504529e-01,4.503493e-01,4.502457e-01,4.501422e-01,4.500386e-01,4.499351e-01,4.498317e-01,4.497282e-01,4.496248e-01,4.495213e-01,4.494179e-01,4.493146e-01,4.492112e-01,4.491079e-01,4.490046e-01,4.489014e-01,4.487981e-01,4.486949e-01,4.485917e-01,4.484885e-01,4.483854e-01,4.482822e-01,4.481791e-01,4.480760e-01,4.479730e-01,4.478700e-01,4.477669e-01,4.476640e-01,4.475610e-01,4.474581e-01,4.473551e-01,4.472522e-01,4.471494e-01,4.470465e-01,4.469437e-01,4.468409e-01,4.467381e-01,4.466354e-01,4.465327e-01,4.464300e-01,4.463273e-01,4.462246e-01,4.461220e-01,4.460194e-01,4.459168e-01,4.458142e-01,4.457117e-01,4.456092e-01,4.455067e-01,4.454042e-01,4.453018e-01,4.451994e-01,4.450970e-01,4.449946e-01,4.448923e-01,4.447899e-01,4.446876e-01,4.445854e-01,4.444831e-01,4.443809e-01,4.442787e-01,4.441765e-01,4.440743e-01,4.439722e-01,4.438701e-01,4.437680e-01,4.436659e-01,4.435639e-01,4.434618e-01,4.433598e-01,4.432579e-01,4.431559e-01,4.430540e-01,4.429521e-01,4.428502e-01,4.427484e-01,4.426465e-01,4.425447e-01,4.424429e-01,4.423412e-01,4.422394e-01,4.421377e-01,4.420360e-01,4.419344e-01,4.418327e-01,4.417311e-01,4.416295e-01,4.415279e-01,4.414264e-01,4.413248e-01,4.412233e-01,4.411219e-01,4.410204e-01,4.409190e-01,4.408176e-01,4.407162e-01,4.406148e-01,4.405135e-01,4.404121e-01,4.403108e-01,4.402096e-01,4.401083e-01,4.400071e-01,4.399059e-01,4.398047e-01,4.397036e-01,4.396024e-01,4.395013e-01,4.394002e-01,4.392992e-01,4.391981e-01,4.390971e-01,4.389961e-01,4.388952e-01,4.387942e-01,4.386933e-01,4.385924e-01,4.384915e-01,4.383907e-01,4.382898e-01,4.381890e-01,4.380882e-01,4.379875e-01,4.378867e-01,4.377860e-01,4.376853e-01,4.375847e-01,4.374840e-01,4.373834e-01,4.372828e-01,4.371822e-01,4.370817e-01,4.369812e-01,4.368806e-01,4.367802e-01,4.366797e-01,4.365793e-01,4.364789e-01,4.363785e-01,4.362781e-01,4.361778e-01,4.360774e-01,4.359771e-01,4.358769e-01,4.357766e-01,4.356764e-01,4.355762e-01,4.354760e-01,4.353758e-01,4.352757e-01,4.351756e-01,4.350755e-01,4.349754e-01,4.348754e-01,4.347754e-01,4.346754e-01,4.345754e-01,4.344754e-01,4.343755e-01,4.342756e-01,4.341757e-01,4.340759e-01,4.339760e-01,4.338762e-01,4.337764e-01,4.336766e-01,4.335769e-01,4.334772e-01,4.333775e-01,4.332778e-01,4.331781e-01,4.330785e-01,4.329789e-01,4.328793e-01,4.327798e-01,4.326802e-01,4.325807e-01,4.324812e-01,4.323817e-01,4.322823e-01,4.321829e-01,4.320835e-01,4.319841e-01,4.318847e-01,4.317854e-01,4.316861e-01,4.315868e-01,4.314875e-01,4.313883e-01,4.312891e-01,4.311899e-01,4.310907e-01,4.309915e-01,4.308924e-01,4.307933e-01,4.306942e-01,4.305952e-01,4.304961e-01,4.303971e-01,4.302981e-01,4.301992e-01,4.301002e-01,4.300013e-01,4.299024e-01,4.298035e-01,4.297047e-01,4.296058e-01,4.295070e-01,4.294082e-01,4.293095e-01,4.292107e-01,4.291120e-01,4.290133e-01,4.289146e-01,4.288160e-01,4.287174e-01,4.286188e-01,4.285202e-01,4.284216e-01,4.283231e-01,4.282246e-01,4.281261e-01,4.280276e-01,4.279292e-01,4.278307e-01,4.277323e-01,4.276340e-01,4.275356e-01,4.274373e-01,4.273390e-01,4.272407e-01,4.271424e-01,4.270442e-01,4.269459e-01,4.268477e-01,4.267496e-01,4.266514e-01,4.265533e-01,4.264552e-01,4.263571e-01,4.262590e-01,4.261610e-01,4.260630e-01,4.259650e-01,4.258670e-01,4.257691e-01,4.256711e-01,4.255732e-01,4.254753e-01,4.253775e-01,4.252796e-01,4.251818e-01,4.250840e-01,4.249863e-01,4.248885e-01,4.247908e-01,4.246931e-01,4.245954e-01,4.244978e-01,4.244001e-01,4.243025e-01,4.242049e-01,4.241074e-01,4.240098e-01,4.239123e-01,4.238148e-01,4.237173e-01,4.236199e-01,4.235224e-01,4.234250e-01,4.233276e-01,4.232303e-01,4.231329e-01,4.230356e-01,4.229383e-01,4.228410e-01,4.227438e-01,4.226465e-01,4.225493e-01,4.224521e-01,4.223550e-01,4.222578e-01,4.221607e-01,4.220636e-01,4.219666e-01,4.218695e-01,4.217725e-01,4.216755e-01,4.215785e-01,4.214815e-01,4.213846e-01,4.212877e-01,4.211908e-01,4.210939e-01,4.209970e-01,4.209002e-01,4.208034e-01,4.207066e-01,4.206098e-01,4.205131e-01,4.204164e-01,4.203197e-01,4.202230e-01,4.201264e-01,4.200297e-01,4.199331e-01,4.198365e-01,4.197400e-01,4.196434e-01,4.195469e-01,4.194504e-01,4.193540e-01,4.192575e-01,4.191611e-01,4.190647e-01,4.189683e-01,4.188719e-01,4.187756e-01,4.186793e-01,4.185830e-01,4.184867e-01,4.183904e-01,4.182942e-01,4.181980e-01,4.181018e-01,4.180057e-01,4.179095e-01,4.178134e-01,4.177173e-01,4.176212e-01,4.175252e-01,4.174291e-01,4.173331e-01,4.172371e-01,4.171412e-01,4.170452e-01,4.169493e-01,4.168534e-01,4.167575e-01,4.166617e-01,4.165659e-01,4.164700e-01,4.163743e-01,4.162785e-01,4.161827e-01,4.160870e-01,4.159913e-01,4.158956e-01,4.158000e-01,4.157044e-01,4.156087e-01,4.155132e-01,4.154176e-01,4.153220e-01,4.152265e-01,4.151310e-01,4.150355e-01,4.149401e-01,4.148446e-01,4.147492e-01,4.146538e-01,4.145585e-01,4.144631e-01,4.143678e-01,4.142725e-01,4.141772e-01,4.140819e-01,4.139867e-01,4.138915e-01,4.137963e-01,4.137011e-01,4.136060e-01,4.135108e-01,4.134157e-01,4.133206e-01,4.132256e-01,4.131305e-01,4.130355e-01,4.129405e-01,4.128455e-01,4.127506e-01,4.126557e-01,4.125607e-01,4.124659e-01,4.123710e-01,4.122761e-01,4.121813e-01,4.120865e-01,4.119917e-01,4.118970e-01,4.118022e-01,4.117075e-01,4.116128e-01,4.115182e-01,4.114235e-01,4.113289e-01,4.112343e-01,4.111397e-01,4.110451e-01,4.109506e-01,4.108561e-01,4.107616e-01,4.106671e-01,4.105727e-01,4.104782e-01,4.103838e-01,4.102894e-01,4.101951e-01,4.101007e-01,4.100064e-01,4.099121e-01,4.098178e-01,4.097235e-01,4.096293e-01,4.095351e-01,4.094409e-01,4.093467e-01,4.092526e-01,4.091585e-01,4.090643e-01,4.089703e-01,4.088762e-01,4.087822e-01,4.086881e-01,4.085941e-01,4.085002e-01,4.084062e-01,4.083123e-01,4.082184e-01,4.081245e-01,4.080306e-01,4.079368e-01,4.078429e-01,4.077491e-01,4.076553e-01,4.075616e-01,4.074678e-01,4.073741e-01,4.072804e-01,4.071868e-01,4.070931e-01,4.069995e-01,4.069059e-01,4.068123e-01,4.067187e-01,4.066252e-01,4.065316e-01,4.064381e-01,4.063447e-01,4.062512e-01,4.061578e-01,4.060643e-01,4.059710e-01,4.058776e-01,4.057842e-01,4.056909e-01,4.055976e-01,4.055043e-01,4.054110e-01,4.053178e-01,4.052246e-01,4.051314e-01,4.050382e-01,4.049450e-01,4.048519e-01,4.047588e-01,4.046657e-01,4.045726e-01,4.044796e-01,4.043865e-01,4.042935e-01,4.042005e-01,4.041076e-01,4.040146e-01,4.039217e-01,4.038288e-01,4.037359e-01,4.036430e-01,4.035502e-01,4.034574e-01,4.033646e-01,4.032718e-01,4.031791e-01,4.030863e-01,4.029936e-01,4.029009e-01,4.028083e-01,4.027156e-01,4.026230e-01,4.025304e-01,4.024378e-01,4.023453e-01,4.022527e-01,4.021602e-01,4.020677e-01,4.019752e-01,4.018828e-01,4.017903e-01,4.016979e-01,4.016055e-01,4.015132e-01,4.014208e-01,4.013285e-01,4.012362e-01,4.011439e-01,4.010516e-01,4.009594e-01,4.008672e-01,4.007750e-01,4.006828e-01,4.005906e-01,4.004985e-01,4.004064e-01,4.003143e-01,4.002222e-01,4.001302e-01,4.000381e-01,3.999461e-01,3.998542e-01,3.997622e-01,3.996702e-01,3.995783e-01,3.994864e-01,3.993945e-01,3.993027e-01,3.992108e-01,3.991190e-01,3.990272e-01,3.989354e-01,3.988437e-01,3.987519e-01,3.986602e-01,3.985685e-01,3.984769e-01,3.983852e-01,3.982936e-01,3.982020e-01,3.981104e-01,3.980188e-01,3.979273e-01,3.978358e-01,3.977443e-01,3.976528e-01,3.975613e-01,3.974699e-01,3.973785e-01,3.972871e-01,3.971957e-01,3.971043e-01,3.970130e-01,3.969217e-01,3.968304e-01,3.967391e-01,3.966479e-01,3.965567e-01,3.964654e-01,3.963743e-01,3.962831e-01,3.961919e-01,3.961008e-01,3.960097e-01,3.959186e-01,3.958276e-01,3.957365e-01,3.956455e-01,3.955545e-01,3.954635e-01,3.953726e-01,3.952816e-01,3.951907e-01,3.950998e-01,3.950090e-01,3.949181e-01,3.948273e-01,3.947365e-01,3.946457e-01,3.945549e-01,3.944642e-01,3.943734e-01,3.942827e-01,3.941920e-01,3.941014e-01,3.940107e-01,3.939201e-01,3.938295e-01,3.937389e-01,3.936484e-01,3.935578e-01,3.934673e-01,3.933768e-01,3.932863e-01,3.931959e-01,3.931055e-01,3.930150e-01,3.929246e-01,3.928343e-01,3.927439e-01,3.926536e-01,3.925633e-01,3.924730e-01,3.923827e-01,3.922925e-01,3.922022e-01,3.921120e-01,3.920219e-01,3.919317e-01,3.918415e-01,3.917514e-01,3.916613e-01,3.915712e-01,3.914812e-01,3.913911e-01,3.913011e-01,3.912111e-01,3.911211e-01,3.910312e-01,3.909412e-01,3.908513e-01,3.907614e-01,3.906716e-01,3.905817e-01,3.904919e-01,3.904021e-01,3.903123e-01,3.902225e-01,3.901327e-01,3.900430e-01,3.899533e-01,3.898636e-01,3.897739e-01,};
@@ -39,6 +39,10 @@
  * to discover the audible sounds for the new positions, and the
  * aave_set_listener_orientation() function is called when the
  * listener moves her head.
+ *
+ * The order of reflections calculated for each sound source is limited
+ * by its level of detail policy, set with aave_set_source_lod(), so that
+ * aave_update() spends its time on the sources that are most audible.
  */
 
 #include <math.h> /* M_PI, acos(), atan2(), sqrt() */
@@ -292,10 +296,18 @@ static void aave_create_sound(struct aave *aave, struct aave_source *source,
 			return;
 	}
 
-	/* Allocate sound. */
+	/* Allocate sound, and its right ear if the HRTF set has delays. */
 	sound = calloc(1, sizeof *sound);
 	if (!sound)
 		return;
+	if (__atomic_load_n(&aave->hrtf_delays, __ATOMIC_ACQUIRE)) {
+		sound->dft_right = calloc(AAVE_MAX_HRTF * 4,
+						sizeof *sound->dft_right);
+		if (!sound->dft_right) {
+			free(sound);
+			return;
+		}
+	}
 
 	/* Copy the geometric data to the sound. */
 	for (i = 0; i < order; i++) {
@@ -308,6 +320,8 @@ static void aave_create_sound(struct aave *aave, struct aave_source *source,
 
 	/* Design the material absortion filter. */
 	aave_get_material_filter(aave, sound->surfaces, order, sound->filter);
+	sound->filter_gain = aave_get_material_gain(sound->surfaces, order);
+	sound->stride = aave_get_material_stride(sound->surfaces, order);
 
 	/* Set the origin of the sound. */
 	if (order == 0)
@@ -376,6 +390,47 @@ static void aave_create_sounds(struct aave *aave, struct aave_source *source,
 						surfaces, image_sources);
 }
 
+/**
+ * Return the order of reflections to calculate for the sound source
+ * pointed by @p source, according to its level of detail policy.
+ */
+static unsigned aave_source_reflections(const struct aave *aave,
+					const struct aave_source *source)
+{
+	float v[3], d, r;
+	unsigned i, order;
+
+	order = aave->reflections;
+
+	switch (source->lod) {
+	case AAVE_LOD_FIXED:
+		if (source->lod_param < order)
+			order = source->lod_param;
+		break;
+	case AAVE_LOD_DISTANCE:
+		r = aave->lod_distance;
+		if (r <= 0)
+			r = AAVE_LOD_REFERENCE_DISTANCE;
+		for (i = 0; i < 3; i++)
+			v[i] = source->position[i] - aave->position[i];
+		d = norm(v);
+		/* One order less for each doubling of the distance. */
+		while (d > r && order > 0) {
+			r *= 2;
+			order--;
+		}
+		break;
+	case AAVE_LOD_PRIORITY:
+		if (source->lod_param < order)
+			order -= source->lod_param;
+		else
+			order = 0;
+		break;
+	}
+
+	return order;
+}
+
 /**
  * Update the distance and azimuth of the listener relative to a sound source.
  * Calculate the (distance, elevation, azimuth) vector
@@ -432,6 +487,56 @@ void aave_get_coordinates(const struct aave *aave, const float *source_position,
 	*distance = dist;
 }
 
+/**
+ * Get the @p azimuth (rad) and @p elevation (rad) coordinates of the unit
+ * vector @p direction in the axes of the listener (see aave_get_directions()),
+ * as aave_get_coordinates() does.
+ */
+void aave_get_angles(const float *direction, float *elevation, float *azimuth)
+{
+	float z = direction[2];
+
+	if (z > 1)
+		z = 1;
+	else if (z < -1)
+		z = -1;
+
+	*azimuth = - atan2f(direction[1], direction[0]);
+	*elevation = acosf(z) - M_PI / 2;
+}
+
+/**
+ * Get the distance and direction relative to the listener of all sounds
+ * that are audible or fading out, for the next audio block, into their
+ * distance_current and direction members: the direction is the unit vector
+ * from the listener in the axes of the listener.
+ *
+ * This is the transform of aave_get_coordinates() in one pass over the
+ * sounds, without the conversion to angles, since the HRTF pair is taken
+ * from the direction lookup table of the HRTF set (see hrtf_lookup.c).
+ */
+void aave_get_directions(struct aave *aave)
+{
+	struct aave_sound *s;
+	float vector[3], d;
+	unsigned i, j;
+
+	for (i = 0; i < AAVE_MAX_REFLECTIONS; i++) {
+		for (s = aave->sounds[i]; s; s = s->next) {
+			if (!s->audible && !s->fade_samples)
+				continue;
+			for (j = 0; j < 3; j++)
+				vector[j] = s->position[j] - aave->position[j];
+			d = norm(vector);
+			s->distance_current = d;
+			d = d > 0 ? 1 / d : 0;
+			for (j = 0; j < 3; j++)
+				s->direction[j] = d * dot_product(
+						aave->orientation[j], vector);
+		}
+	}
+}
+
 /**
  * Add a sound source to the auralisation world.
  */
@@ -525,6 +630,23 @@ void aave_set_listener_position(struct aave *aave,
 	aave->position[2] = z;
 }
 
+/**
+ * Set the reflection order level of detail policy of a sound source.
+ * @p lod is one of AAVE_LOD_GLOBAL, AAVE_LOD_FIXED, AAVE_LOD_DISTANCE or
+ * AAVE_LOD_PRIORITY, and @p param is the maximum order of reflections for
+ * AAVE_LOD_FIXED or the priority of the source for AAVE_LOD_PRIORITY
+ * (ignored otherwise).
+ *
+ * The aave_update() function should be called afterwards to update the
+ * state of the auralisation engine to reflect the new policy.
+ */
+void aave_set_source_lod(struct aave_source *source, unsigned lod,
+							unsigned param)
+{
+	source->lod = lod;
+	source->lod_param = param;
+}
+
 /**
  * Set the position of a sound source.
  *
@@ -538,6 +660,36 @@ void aave_set_source_position(struct aave_source *source, float x, float y, floa
 	source->position[2] = z;
 }
 
+/**
+ * Allocate the DFT of the right ear of the sounds of the auralisation
+ * world @p aave that have none, once an HRTF set with delays is selected,
+ * and let the audio thread switch to it (see aave_hrtf_lookup_apply()).
+ * If out of memory, this is tried again by the next call.
+ */
+static void aave_update_ears(struct aave *aave)
+{
+	struct aave_sound *s;
+	aave_spectrum *p;
+	unsigned i;
+
+	if (__atomic_load_n(&aave->hrtf_delays, __ATOMIC_ACQUIRE)
+					!= AAVE_HRTF_DELAYS_SELECTED)
+		return;
+
+	for (i = 0; i < AAVE_MAX_REFLECTIONS; i++)
+		for (s = aave->sounds[i]; s; s = s->next)
+			if (!s->dft_right) {
+				p = calloc(AAVE_MAX_HRTF * 4, sizeof *p);
+				if (!p)
+					return;
+				__atomic_store_n(&s->dft_right, p,
+							__ATOMIC_RELEASE);
+			}
+
+	__atomic_store_n(&aave->hrtf_delays, AAVE_HRTF_DELAYS_READY,
+							__ATOMIC_RELEASE);
+}
+
 /**
  * Update the whole state of the auralisation world.
  * Runs the visibility checks for all sounds from all sources.
@@ -547,14 +699,36 @@ void aave_update(struct aave *aave)
 	struct aave_sound *sound;
 	struct aave_source *source;
 	unsigned i;
+	double t = 0;
 
-	/* First update the sounds that were previously visible. */
-	for (i = 0; i <= aave->reflections; i++)
+	if (aave->quality.target > 0) {
+		t = aave_quality_clock();
+		aave_quality_apply(aave);
+	}
+
+	aave_update_ears(aave);
+
+	/* Select the order of reflections to calculate for each source. */
+	for (source = aave->sources; source; source = source->next)
+		source->reflections = aave_source_reflections(aave, source);
+
+	/*
+	 * First update the sounds that were previously visible.
+	 * The sounds above the order of their source fade out.
+	 */
+	for (i = 0; i < AAVE_MAX_REFLECTIONS; i++)
 		for (sound = aave->sounds[i]; sound; sound = sound->next)
-			aave_update_sound(aave, sound, i);
+			if (i > sound->source->reflections)
+				sound->audible = 0;
+			else
+				aave_update_sound(aave, sound, i);
 
 	/* Then update everything else. */
 	for (i = 0; i <= aave->reflections; i++)
 		for (source = aave->sources; source; source = source->next)
-			aave_create_sounds(aave, source, i);
+			if (i <= source->reflections)
+				aave_create_sounds(aave, source, i);
+
+	if (aave->quality.target > 0)
+		aave_quality_account(aave, aave_quality_clock() - t, 0);
 }
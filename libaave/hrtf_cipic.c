@@ -64,7 +64,8 @@ extern const float hrtf_cipic_set_008[][1024];
  * Currently, all elevations map to elevation 0.
  * @todo Use all elevation measures available, not just 0 degrees.
  */
-static void aave_hrtf_cipic_get(const float *hrtf[2], int elevation, int azimuth)
+static void aave_hrtf_cipic_get(const struct aave *aave, const float *hrtf[2],
+				int elevation, int azimuth)
 {
 	if (azimuth <= -80) {
 		hrtf[0] = hrtf_cipic_set[0];
@@ -145,11 +146,10 @@ static void aave_hrtf_cipic_get(const float *hrtf[2], int elevation, int azimuth
 }
 
 /**
- * Select the CIPIC HRTF set for the auralisation process.
+ * Select the CIPIC HRTF set for the auralisation process
+ * (see aave_hrtf_lookup_init()).
  */
 void aave_hrtf_cipic(struct aave *a)
 {
-	a->hrtf_frames = 256;
-	a->hrtf_get = aave_hrtf_cipic_get;
-	a->hrtf_output_buffer_index = 0;
+	aave_hrtf_lookup_init(a, aave_hrtf_cipic_get, 0, 256);
 }
@@ -0,0 +1,267 @@
+/*   This file is part of LibAAVE.
+ * 
+ *   LibAAVE is free software: you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation, either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   LibAAVE is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with LibAAVE.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *   Copyright 2014 André Oliveira, Nuno Silva, Guilherme Campos,
+ *   Paulo Dias, José Vieira/IEETA - Universidade de Aveiro
+ *
+ *
+ *   libaave/hrtf_file.c: HRTF sets read from memory-mapped files
+ */
+
+/**
+ * @file hrtf_file.c
+ *
+ * The hrtf_file.c file implements the interface to use HRTF sets read from
+ * HRTF files, instead of the sets compiled in the library. To select a set
+ * for the auralisation process, call aave_hrtf_file() with the name of its
+ * file, at any time: the subject can be switched while running, from any
+ * thread, as with the sets compiled in the library (see hrtf_lookup.c).
+ *
+ * An HRTF file has a header (struct aave_hrtf_file_header), a direction
+ * index, and the spectra of the HRTFs, already transformed to the layout
+ * of dft.h, as the sets compiled in the library, so that they are used
+ * directly from the file, mapped in memory: the pages of the spectra are
+ * only read from the disk when a sound first uses them.
+ *
+ * The direction index is a grid with the left and right spectra to use
+ * for each elevation, from -90 to 90 degrees, and, in each elevation, for
+ * each azimuth, from -180 to 180 degrees, in steps of the same number of
+ * degrees, so that getting the HRTF pair of a direction is a table lookup.
+ * A spectrum can be shared by many directions (e.g. by the mirror direction
+ * of the other ear), and the spectra start at a page boundary.
+ *
+ * The spectra may be minimum-phase HRTFs with a separate delay each (see
+ * hrtf_minphase.c), which are much shorter than the HRTFs they come from.
+ * The delays are then applied to the sounds with the resampler of audio.c,
+ * per ear, which also interpolates them smoothly as the sounds move.
+ *
+ * The tools/hrtf_file.c program writes the sets compiled in the library
+ * to HRTF files, and tools/hrtf_sofa.c converts SOFA (AES69) HRIR sets.
+ */
+
+#include <stdlib.h> /* calloc() */
+#include <string.h> /* memcmp() */
+#include "aave.h"
+
+#ifdef _WIN32
+#include <stdio.h> /* fopen() */
+#else
+#include <fcntl.h> /* open() */
+#include <sys/mman.h> /* mmap() */
+#include <sys/stat.h> /* fstat() */
+#include <unistd.h> /* close() */
+#endif
+
+/**
+ * Get the HRTF pair of the HRTF file @p file for the specified coordinates.
+ * @p elevation is [-90;90] degrees. @p azimuth is [-180;180] degrees.
+ * @p hrtf[0] will be the left HRTF, @p hrtf[1] the right HRTF.
+ */
+void aave_hrtf_file_pair(const struct aave_hrtf_file *file,
+			const float *hrtf[2], int elevation, int azimuth)
+{
+	unsigned step = file->header->step, n = file->header->frames * 4;
+	const unsigned *pair;
+
+	if (elevation < -90)
+		elevation = -90;
+	else if (elevation > 90)
+		elevation = 90;
+	if (azimuth < -180)
+		azimuth = -180;
+	else if (azimuth > 180)
+		azimuth = 180;
+
+	/* The nearest direction of the grid. */
+	pair = file->index[(elevation + 90 + step / 2) / step * file->azimuths
+				+ (azimuth + 180 + step / 2) / step];
+
+	hrtf[0] = file->spectra + pair[0] * n;
+	hrtf[1] = file->spectra + pair[1] * n;
+}
+
+/**
+ * Get the HRTF pair of the HRTF file of the auralisation world @p aave
+ * for the specified coordinates (see aave_hrtf_file_pair()).
+ */
+static void aave_hrtf_file_get(const struct aave *aave, const float *hrtf[2],
+				int elevation, int azimuth)
+{
+	aave_hrtf_file_pair(aave->hrtf_file, hrtf, elevation, azimuth);
+}
+
+/**
+ * Release the HRTF file @p file.
+ */
+void aave_hrtf_file_free(struct aave_hrtf_file *file)
+{
+#ifdef _WIN32
+	free((void *)file->data);
+#else
+	munmap((void *)file->data, file->size);
+#endif
+	free(file);
+}
+
+/**
+ * Check that the HRTF file of @p size bytes pointed by @p p is valid,
+ * and store the location of its parts in @p file.
+ * Returns 0 on success, or -1 otherwise.
+ */
+static int aave_hrtf_file_parse(struct aave_hrtf_file *file,
+				const unsigned char *p, unsigned long size)
+{
+	const struct aave_hrtf_file_header *h;
+	unsigned long n, i;
+
+	h = (const struct aave_hrtf_file_header *)p;
+	if (size < sizeof *h || memcmp(h->magic, "AAVEHRTF", 8)
+	    || h->version != AAVE_HRTF_FILE_VERSION)
+		return -1;
+
+	/* The frames must be a power of 2 the library supports. */
+	if (h->frames < 2 || h->frames > AAVE_MAX_HRTF
+	    || (h->frames & (h->frames - 1)))
+		return -1;
+	if (!h->step || 90 % h->step || !h->count)
+		return -1;
+
+	file->azimuths = 360 / h->step + 1;
+	n = (180 / h->step + 1) * file->azimuths;
+	if (h->offset % sizeof(float) || h->offset < sizeof *h + n * 8
+	    || h->offset > size
+	    || (size - h->offset) / (h->frames * 4 * sizeof(float)) < h->count)
+		return -1;
+
+	file->data = p;
+	file->size = size;
+	file->header = h;
+	file->index = (const unsigned (*)[2])(h + 1);
+	file->spectra = (const float *)(p + h->offset);
+
+	if (h->delays) {
+		if (h->delays % sizeof(float) || h->delays < sizeof *h
+		    || h->delays > size
+		    || (size - h->delays) / sizeof(float) < h->count)
+			return -1;
+		file->delays = (const float *)(p + h->delays);
+	}
+
+	for (i = 0; i < n; i++)
+		if (file->index[i][0] >= h->count
+		    || file->index[i][1] >= h->count)
+			return -1;
+
+	return 0;
+}
+
+/**
+ * Select the HRTF set of the HRTF file @p filename, mapped in memory,
+ * for the auralisation process (see aave_hrtf_lookup_init()). The file
+ * remains mapped until the audio thread no longer uses the set, after
+ * another set is selected, or until aave_hrtf_close().
+ * Returns 0 on success, or -1 if the file could not be read, is not a
+ * valid HRTF file, or, once the audio has started, its number of frames
+ * differs from that of the set in use, in which case the set in use
+ * remains selected.
+ */
+int aave_hrtf_file(struct aave *a, const char *filename)
+{
+	struct aave_hrtf_file *file;
+	unsigned long size;
+#ifdef _WIN32
+	unsigned char *data;
+	FILE *f;
+
+	f = fopen(filename, "rb");
+	if (!f)
+		return -1;
+	fseek(f, 0, SEEK_END);
+	size = ftell(f);
+	fseek(f, 0, SEEK_SET);
+	data = malloc(size + 1);
+	if (!data || fread(data, 1, size, f) != size) {
+		free(data);
+		fclose(f);
+		return -1;
+	}
+	fclose(f);
+#else
+	struct stat st;
+	void *data;
+	int fd;
+
+	fd = open(filename, O_RDONLY);
+	if (fd < 0)
+		return -1;
+	if (fstat(fd, &st) < 0 || st.st_size == 0) {
+		close(fd);
+		return -1;
+	}
+	size = st.st_size;
+	data = mmap(0, size, PROT_READ, MAP_PRIVATE, fd, 0);
+	close(fd);
+	if (data == MAP_FAILED)
+		return -1;
+#endif
+
+	file = calloc(1, sizeof *file);
+	if (!file) {
+#ifdef _WIN32
+		free(data);
+#else
+		munmap(data, size);
+#endif
+		return -1;
+	}
+	if (aave_hrtf_file_parse(file, data, size) < 0) {
+		file->data = data;
+		file->size = size;
+		aave_hrtf_file_free(file);
+		return -1;
+	}
+
+	if (aave_hrtf_lookup_init(a, aave_hrtf_file_get, file,
+						file->header->frames) < 0) {
+		aave_hrtf_file_free(file);
+		return -1;
+	}
+	return 0;
+}
+
+/**
+ * Return the delay, in samples, of the spectrum @p hrtf of the HRTF
+ * file @p file, or 0 if it is NULL or has no delays.
+ */
+float aave_hrtf_delay(const struct aave_hrtf_file *file, const float *hrtf)
+{
+	unsigned long i;
+
+	if (!file || !file->delays || hrtf < file->spectra)
+		return 0;
+
+	i = (hrtf - file->spectra) / (file->header->frames * 4);
+	return i < file->header->count ? file->delays[i] : 0;
+}
+
+/**
+ * Release the HRTF sets of the auralisation world @p aave, and the HRTF
+ * files they were read from, when the audio is stopped. A set must be
+ * selected again before the audio is restarted.
+ */
+void aave_hrtf_close(struct aave *aave)
+{
+	aave_hrtf_lookup_free(aave);
+}
@@ -51,7 +51,8 @@ extern const float hrtf_listen_set_1040[][2][2048];
  * @p elevation is [-90;90] degrees. @p azimuth is [-180;180] degrees.
  * @p hrtf[0] will be the left HRTF, @p hrtf[1] the right HRTF.
  */
-static void aave_hrtf_listen_get(const float *hrtf[2], int elevation, int azimuth)
+static void aave_hrtf_listen_get(const struct aave *aave, const float *hrtf[2],
+				int elevation, int azimuth)
 {
 	unsigned i;
 
@@ -73,11 +74,10 @@ static void aave_hrtf_listen_get(const float *hrtf[2], int elevation, int azimut
 }
 
 /**
- * Select the LISTEN HRTF set for the auralisation process.
+ * Select the LISTEN HRTF set for the auralisation process
+ * (see aave_hrtf_lookup_init()).
  */
 void aave_hrtf_listen(struct aave *a)
 {
-	a->hrtf_frames = 512;
-	a->hrtf_get = aave_hrtf_listen_get;
-	a->hrtf_output_buffer_index = 0;
+	aave_hrtf_lookup_init(a, aave_hrtf_listen_get, 0, 512);
 }
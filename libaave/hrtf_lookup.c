@@ -0,0 +1,693 @@
+/*   This file is part of LibAAVE.
+ * 
+ *   LibAAVE is free software: you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation, either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   LibAAVE is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with LibAAVE.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *   Copyright 2014 André Oliveira, Nuno Silva, Guilherme Campos,
+ *   Paulo Dias, José Vieira/IEETA - Universidade de Aveiro
+ *
+ *
+ *   libaave/hrtf_lookup.c: direction lookup table of the HRTF sets
+ */
+
+/**
+ * @file hrtf_lookup.c
+ *
+ * The hrtf_lookup.c file implements the direction lookup table of the HRTF
+ * sets, which gets the HRTF pair of a sound from its direction, a unit
+ * vector (see aave_get_directions()), in constant time: without converting
+ * the direction to angles (atan2f(), acosf()), and without the search of
+ * the hrtf_get() function of each set (e.g. the if-chains of hrtf_cipic.c).
+ *
+ * The unit sphere is mapped to a square with the octahedral map: the
+ * vector is projected onto the octahedron |x| + |y| + |z| = 1, whose upper
+ * half (z >= 0) unfolds onto the inner diamond |x| + |y| <= 1 of the square
+ * [-1;1]x[-1;1], and whose lower half folds over the four corners. The
+ * solid angle of the cells varies less than that of a grid of angles,
+ * with no cells crowded at the poles, and the map is cheap both ways
+ * (Q. Meyer et al., "On Floating-Point Normal Vectors", Computer
+ * Graphics Forum 29(4), 2010).
+ *
+ * The table holds the HRTF pair of each of the AAVE_HRTF_LOOKUP_SIZE x
+ * AAVE_HRTF_LOOKUP_SIZE cells, with the delays of the pairs (see
+ * hrtf_minphase.c). It is the only way the audio processing gets the HRTF
+ * pairs of the sounds, and gives exactly the pair of hrtf_get() for the
+ * angles of the direction (see aave_get_angles()): a cell holds a pair only
+ * if hrtf_get() gives it for all the angles, in whole degrees, of the
+ * directions of the cell, bounded from its edges. The cells across the
+ * boundary of two pairs hold none, and their directions are converted to
+ * angles for hrtf_get(), as the sounds were before the table, which is
+ * slower.
+ *
+ * Selecting an HRTF set (aave_hrtf_cipic(), aave_hrtf_file(), ...) builds
+ * its table on the thread that selects it, which may be another thread
+ * than the audio thread, and queues it. The audio thread switches to the
+ * table queued last at the start of its next audio block, and the tables
+ * it replaced, with the HRTF files they were read from, are released by
+ * a later selection, once a whole block was rendered without them, as the
+ * sounds crossfade from their previous HRTF pairs for one block. Before
+ * the first audio block, the set is switched at once. The audio thread
+ * never waits for a selection in progress: it only tries to take the lock
+ * of the queue, and switches at a later block if it is busy, except at its
+ * first block, which must wait for any switch at once to be done.
+ */
+
+#include <math.h> /* fabsf() */
+#include <pthread.h> /* pthread_mutex_lock() */
+#include <stdlib.h> /* malloc() */
+#include "aave.h"
+
+/**
+ * Queue of the direction lookup tables of the HRTF sets selected for an
+ * auralisation world, between the threads that select them and the audio
+ * thread.
+ */
+struct aave_hrtf_queue {
+
+	/** Protects the other members and the switch of the table in use. */
+	pthread_mutex_t mutex;
+
+	/** Table of the set selected last, for the next audio block, or NULL. */
+	struct aave_hrtf_lookup *pending;
+
+	/** Tables the audio thread switched from, linked by @p next. */
+	struct aave_hrtf_lookup *retired;
+
+	/**
+	 * Number of audio blocks started, counted when the audio thread got
+	 * the lock at their start.
+	 */
+	unsigned long blocks;
+};
+
+/**
+ * Number of points sampled along each edge of a cell of the direction
+ * lookup table to bound the angles of its directions.
+ */
+#define AAVE_HRTF_LOOKUP_EDGE 16
+
+/**
+ * Margin of the bounds of the angles of a cell, in degrees, for the error
+ * of the sampling of its edges and of the rounding of the directions.
+ */
+#define AAVE_HRTF_LOOKUP_MARGIN 0.01
+
+/**
+ * Get the cell of the direction lookup table of the vector @p v
+ * (octahedral map).
+ */
+static unsigned aave_hrtf_lookup_cell(const float v[3])
+{
+	float s, x, y, t;
+	int i, j;
+
+	s = fabsf(v[0]) + fabsf(v[1]) + fabsf(v[2]);
+	if (s == 0)
+		return 0;
+	x = v[0] / s;
+	y = v[1] / s;
+
+	/* Fold the lower half over the corners. */
+	if (v[2] < 0) {
+		t = x;
+		x = (1 - fabsf(y)) * (t < 0 ? -1 : 1);
+		y = (1 - fabsf(t)) * (y < 0 ? -1 : 1);
+	}
+
+	i = (x + 1) * (AAVE_HRTF_LOOKUP_SIZE / 2);
+	j = (y + 1) * (AAVE_HRTF_LOOKUP_SIZE / 2);
+	if (i > AAVE_HRTF_LOOKUP_SIZE - 1)
+		i = AAVE_HRTF_LOOKUP_SIZE - 1;
+	if (j > AAVE_HRTF_LOOKUP_SIZE - 1)
+		j = AAVE_HRTF_LOOKUP_SIZE - 1;
+
+	return j * AAVE_HRTF_LOOKUP_SIZE + i;
+}
+
+/**
+ * Get the HRTF pair @p hrtf of the set of the direction lookup table
+ * @p lookup, of the auralisation world @p aave, for the specified
+ * coordinates (see hrtf_get() of struct aave).
+ */
+static void aave_hrtf_lookup_get(const struct aave *aave,
+		const struct aave_hrtf_lookup *lookup, const float *hrtf[2],
+		int elevation, int azimuth)
+{
+	if (lookup->hrtf_file)
+		aave_hrtf_file_pair(lookup->hrtf_file, hrtf, elevation,
+								azimuth);
+	else
+		lookup->hrtf_get(aave, hrtf, elevation, azimuth);
+}
+
+#ifdef AAVE_BF16
+/**
+ * Return the bfloat16 copy of the spectrum @p x of the set of the
+ * direction lookup table @p lookup.
+ */
+static const aave_spectrum *aave_hrtf_lookup_find(
+		const struct aave_hrtf_lookup *lookup, const float *x)
+{
+	unsigned n = lookup->hrtf_frames * 4, h;
+
+	h = (unsigned long)x / (n * sizeof(float)) & lookup->mask;
+	while (lookup->spectra[lookup->hash[h] - 1] != x)
+		h = (h + 1) & lookup->mask;
+
+	return lookup->data + (unsigned long)(lookup->hash[h] - 1) * n;
+}
+
+/**
+ * Insert the spectrum @p x of @p n floats in the hash table @p hash, with
+ * @p mask + 1 entries, of the distinct spectra @p spectra, of which there
+ * are @p count. Returns the new count.
+ */
+static unsigned aave_hrtf_lookup_insert(unsigned *hash, unsigned mask,
+		const float **spectra, unsigned count, const float *x,
+		unsigned n)
+{
+	unsigned h = (unsigned long)x / (n * sizeof(float)) & mask;
+
+	while (hash[h] && spectra[hash[h] - 1] != x)
+		h = (h + 1) & mask;
+	if (!hash[h]) {
+		spectra[count++] = x;
+		hash[h] = count;
+	}
+
+	return count;
+}
+
+/**
+ * Make bfloat16 copies of the spectra of the set of the direction lookup
+ * table @p lookup, of the auralisation world @p aave, one of each spectrum
+ * hrtf_get() gives for the whole degrees, with a hash table to find them.
+ * Returns 0 on success, or -1 if out of memory.
+ */
+static int aave_hrtf_lookup_copy(const struct aave *aave,
+					struct aave_hrtf_lookup *lookup)
+{
+	const unsigned size = 181 * 361 * 2;
+	unsigned n = lookup->hrtf_frames * 4, *hash, mask, count, i, c;
+	const float **spectra, *pair[2];
+	int e, a;
+
+	/* Number the distinct spectra (hash table, linear probing). */
+	for (mask = 1; mask < size * 2; mask *= 2)
+		;
+	mask--;
+	hash = calloc(mask + 1, sizeof *hash);
+	spectra = malloc(size * sizeof *spectra);
+	if (!hash || !spectra) {
+		free(hash);
+		free(spectra);
+		return -1;
+	}
+	count = 0;
+	for (e = -90; e <= 90; e++) {
+		for (a = -180; a <= 180; a++) {
+			aave_hrtf_lookup_get(aave, lookup, pair, e, a);
+			for (c = 0; c < 2; c++)
+				count = aave_hrtf_lookup_insert(hash, mask,
+						spectra, count, pair[c], n);
+		}
+	}
+	free(hash);
+
+	/* A smaller hash table for the audio thread, and the copies. */
+	for (mask = 1; mask < count * 2; mask *= 2)
+		;
+	mask--;
+	lookup->mask = mask;
+	lookup->hash = calloc(mask + 1, sizeof *lookup->hash);
+	lookup->spectra = malloc(count * sizeof *lookup->spectra);
+	lookup->data = malloc((unsigned long)count * n * sizeof *lookup->data);
+	if (!lookup->hash || !lookup->spectra || !lookup->data) {
+		free(spectra);
+		return -1;
+	}
+	for (i = 0, c = 0; i < count; i++)
+		c = aave_hrtf_lookup_insert(lookup->hash, mask,
+					lookup->spectra, c, spectra[i], n);
+	for (i = 0; i < count; i++)
+		aave_spectrum_store(lookup->data + (unsigned long)i * n,
+							lookup->spectra[i], n);
+
+	free(spectra);
+	return 0;
+}
+#endif
+
+/**
+ * Get the HRTF pair @p hrtf (left and right) of the HRTF set of the
+ * auralisation world @p aave, and their delays @p delay, in samples (see
+ * aave_hrtf_delay()), for the unit vector @p direction, in the axes of the
+ * listener, from the direction lookup table.
+ */
+void aave_hrtf_lookup(const struct aave *aave, const float *direction,
+			const aave_spectrum *hrtf[2], float delay[2])
+{
+	const struct aave_hrtf_lookup *lookup = aave->hrtf_lookup;
+	unsigned k = aave_hrtf_lookup_cell(direction), c;
+	float elevation, azimuth;
+	const float *pair[2];
+
+	if (lookup->hrtf[k][0]) {
+		hrtf[0] = lookup->hrtf[k][0];
+		hrtf[1] = lookup->hrtf[k][1];
+		delay[0] = lookup->delay[k][0];
+		delay[1] = lookup->delay[k][1];
+		return;
+	}
+
+	/* A cell across a boundary: the pair of the angles. */
+	aave_get_angles(direction, &elevation, &azimuth);
+	aave_hrtf_lookup_get(aave, lookup, pair, elevation * (180/M_PI),
+						azimuth * (180/M_PI));
+	for (c = 0; c < 2; c++) {
+		delay[c] = aave_hrtf_delay(lookup->hrtf_file, pair[c]);
+#ifdef AAVE_BF16
+		hrtf[c] = aave_hrtf_lookup_find(lookup, pair[c]);
+#else
+		hrtf[c] = pair[c];
+#endif
+	}
+}
+
+/**
+ * Release the direction lookup table @p lookup, and the HRTF file of its
+ * set, if any.
+ */
+static void aave_hrtf_lookup_free_table(struct aave_hrtf_lookup *lookup)
+{
+	if (lookup->hrtf_file)
+		aave_hrtf_file_free(lookup->hrtf_file);
+	free(lookup->decoder);
+#ifdef AAVE_BF16
+	free(lookup->data);
+	free(lookup->hash);
+	free(lookup->spectra);
+#endif
+	free(lookup);
+}
+
+/**
+ * Get the unit vector @p v of the point (@p x, @p y) of the square of the
+ * octahedral map.
+ */
+static void aave_hrtf_lookup_unfold(float v[3], float x, float y)
+{
+	float t;
+	unsigned k;
+
+	v[2] = 1 - fabsf(x) - fabsf(y);
+	if (v[2] < 0) {
+		t = x;
+		x = (1 - fabsf(y)) * (t < 0 ? -1 : 1);
+		y = (1 - fabsf(t)) * (y < 0 ? -1 : 1);
+	}
+	v[0] = x;
+	v[1] = y;
+	t = sqrt(v[0] * v[0] + v[1] * v[1] + v[2] * v[2]);
+	for (k = 0; k < 3; k++)
+		v[k] /= t;
+}
+
+/**
+ * Return 1 if hrtf_get() gives the same HRTF pair @p pair for all the
+ * directions of the cell @p k of the direction lookup table @p lookup, of
+ * the auralisation world @p aave, or 0 otherwise.
+ *
+ * The elevation and azimuth of the directions of a cell, with no pole
+ * inside, are bounded by those of its edges; the azimuths of a cell across
+ * the back, where they wrap, are split in [-180;b] and [a;180] degrees.
+ */
+static int aave_hrtf_lookup_uniform(const struct aave *aave,
+		const struct aave_hrtf_lookup *lookup, unsigned k,
+		const float *pair[2])
+{
+	const float h = 2.f / AAVE_HRTF_LOOKUP_SIZE;
+	const int n = AAVE_HRTF_LOOKUP_EDGE;
+	const int c = AAVE_HRTF_LOOKUP_SIZE / 2;
+	double e, a, b, e0 = 90, e1 = -90, n0 = 0, n1 = -180, p0 = 180, p1 = 0;
+	float x, y, v[3], elevation, azimuth;
+	const float *p[2];
+	int t, u, side, i, j, range[2][2];
+
+	i = k % AAVE_HRTF_LOOKUP_SIZE;
+	j = k / AAVE_HRTF_LOOKUP_SIZE;
+
+	/*
+	 * The azimuth of the poles, at the centre and the corners, depends on
+	 * the signs of the zeros; the zero vector also gets cell 0.
+	 */
+	if (((i == c - 1 || i == c) && (j == c - 1 || j == c))
+	    || ((i == 0 || i == 2 * c - 1) && (j == 0 || j == 2 * c - 1)))
+		return 0;
+
+	x = i * h - 1;
+	y = j * h - 1;
+	for (side = 0; side < 4; side++) {
+		for (t = 0; t < n; t++) {
+			switch (side) {
+			case 0:
+				aave_hrtf_lookup_unfold(v, x + t * h / n, y);
+				break;
+			case 1:
+				aave_hrtf_lookup_unfold(v, x + h, y + t * h / n);
+				break;
+			case 2:
+				aave_hrtf_lookup_unfold(v, x + h - t * h / n,
+									y + h);
+				break;
+			default:
+				aave_hrtf_lookup_unfold(v, x, y + h - t * h / n);
+			}
+			aave_get_angles(v, &elevation, &azimuth);
+			e = elevation * (180/M_PI);
+			a = azimuth * (180/M_PI);
+			if (e < e0)
+				e0 = e;
+			if (e > e1)
+				e1 = e;
+			/* Next to the back, the azimuth is also on the other side. */
+			if (a > 180 - AAVE_HRTF_LOOKUP_MARGIN)
+				b = a - 360;
+			else if (a < AAVE_HRTF_LOOKUP_MARGIN - 180)
+				b = a + 360;
+			else
+				b = a;
+			for (u = 0; u < 2; u++, a = b) {
+				if (a <= 0 && a < n0)
+					n0 = a;
+				if (a <= 0 && a > n1)
+					n1 = a;
+				if (a > 0 && a < p0)
+					p0 = a;
+				if (a > 0 && a > p1)
+					p1 = a;
+			}
+		}
+	}
+
+	/* The whole degrees, in the bounds with the margin. */
+	range[0][0] = n0 <= n1 ? n0 - AAVE_HRTF_LOOKUP_MARGIN : 1;
+	range[0][1] = n0 <= n1 ? n1 + AAVE_HRTF_LOOKUP_MARGIN : 0;
+	range[1][0] = p0 <= p1 ? p0 - AAVE_HRTF_LOOKUP_MARGIN : 1;
+	range[1][1] = p0 <= p1 ? p1 + AAVE_HRTF_LOOKUP_MARGIN : 0;
+	if (n0 <= n1 && p0 <= p1) {
+		if (p0 - n1 > 180) {
+			/* Across the back. */
+			range[0][0] = -180;
+			range[1][1] = 180;
+		} else {
+			/* Across the front: one range. */
+			range[0][1] = range[1][1];
+			range[1][0] = 1;
+			range[1][1] = 0;
+		}
+	}
+	e0 -= AAVE_HRTF_LOOKUP_MARGIN;
+	e1 += AAVE_HRTF_LOOKUP_MARGIN;
+
+	for (i = (int)e0 < -90 ? -90 : (int)e0; i <= (int)e1 && i <= 90; i++)
+		for (side = 0; side < 2; side++)
+			for (j = range[side][0]; j <= range[side][1]; j++) {
+				aave_hrtf_lookup_get(aave, lookup, p, i, j);
+				if (p[0] != pair[0] || p[1] != pair[1])
+					return 0;
+			}
+
+	return 1;
+}
+
+/**
+ * Fill the cells of the direction lookup table @p lookup with the HRTF
+ * pairs of its set, for the auralisation world @p aave, or with NULL for
+ * the cells across a boundary of two pairs.
+ * Returns 0 on success, or -1 if out of memory (AAVE_BF16).
+ */
+static int aave_hrtf_lookup_build(const struct aave *aave,
+					struct aave_hrtf_lookup *lookup)
+{
+	float v[3], elevation, azimuth;
+	const float *pair[2];
+	unsigned i, j, k, c;
+
+#ifdef AAVE_BF16
+	if (aave_hrtf_lookup_copy(aave, lookup))
+		return -1;
+#endif
+
+	for (j = 0; j < AAVE_HRTF_LOOKUP_SIZE; j++) {
+		for (i = 0; i < AAVE_HRTF_LOOKUP_SIZE; i++) {
+			/* The pair of the centre of the cell. */
+			aave_hrtf_lookup_unfold(v,
+				(i + 0.5f) * (2.f / AAVE_HRTF_LOOKUP_SIZE) - 1,
+				(j + 0.5f) * (2.f / AAVE_HRTF_LOOKUP_SIZE) - 1);
+			aave_get_angles(v, &elevation, &azimuth);
+			aave_hrtf_lookup_get(aave, lookup, pair,
+						elevation * (180/M_PI),
+						azimuth * (180/M_PI));
+
+			k = j * AAVE_HRTF_LOOKUP_SIZE + i;
+			if (!aave_hrtf_lookup_uniform(aave, lookup, k, pair)) {
+				lookup->hrtf[k][0] = lookup->hrtf[k][1] = NULL;
+				continue;
+			}
+			for (c = 0; c < 2; c++) {
+				lookup->delay[k][c] = aave_hrtf_delay(
+						lookup->hrtf_file, pair[c]);
+#ifdef AAVE_BF16
+				lookup->hrtf[k][c] = aave_hrtf_lookup_find(
+							lookup, pair[c]);
+#else
+				lookup->hrtf[k][c] = pair[c];
+#endif
+			}
+		}
+	}
+
+	return 0;
+}
+
+/**
+ * Select the HRTF set of @p frames frames whose HRTF pairs are got with
+ * @p hrtf_get or, if @p file is not NULL, read from the HRTF file @p file,
+ * for the auralisation world @p aave: build its direction lookup table,
+ * with the Ambisonics decoder if that mode is in use, and queue it for the
+ * next audio block (see above). The sets the audio
+ * thread no longer uses are released.
+ *
+ * If the set has delays, the sounds get the DFT of their right ear from
+ * the next call to aave_update(), the thread that owns them, and the audio
+ * thread only switches to the set after that; a set switched at once,
+ * before the first audio block, renders the sounds that have none yet
+ * without the delays between the ears.
+ *
+ * Once the audio has started, the set must have the same number of frames
+ * as the set in use, since that is the size of the audio blocks, of the
+ * DFTs kept by the sounds and of their filters.
+ *
+ * Returns 0 on success, in which case @p file is released with the set, or
+ * -1 if out of memory or the number of frames differs, in which case the
+ * set in use remains selected.
+ */
+int aave_hrtf_lookup_init(struct aave *aave,
+			void (*hrtf_get)(const struct aave *, const float *[2],
+							int, int),
+			struct aave_hrtf_file *file, unsigned frames)
+{
+	struct aave_hrtf_queue *q = aave->hrtf_queue;
+	struct aave_hrtf_lookup *lookup, *done = NULL, *l, **p;
+
+	lookup = calloc(1, sizeof *lookup);
+	if (!lookup)
+		return -1;
+	lookup->hrtf_get = hrtf_get;
+	lookup->hrtf_file = file;
+	lookup->hrtf_frames = frames;
+	if (aave_hrtf_lookup_build(aave, lookup))
+		goto fail;
+	if (aave->ambisonics && aave_ambisonics_decoder(aave, lookup))
+		goto fail;
+	if (file && file->delays
+	    && !__atomic_load_n(&aave->hrtf_delays, __ATOMIC_RELAXED))
+		__atomic_store_n(&aave->hrtf_delays, AAVE_HRTF_DELAYS_SELECTED,
+							__ATOMIC_RELEASE);
+
+	/* The first set selected creates the queue, before the audio. */
+	if (!q) {
+		q = calloc(1, sizeof *q);
+		if (!q)
+			goto fail;
+		pthread_mutex_init(&q->mutex, NULL);
+		aave->hrtf_queue = q;
+	}
+
+	pthread_mutex_lock(&q->mutex);
+
+	l = q->pending ? q->pending : aave->hrtf_lookup;
+	if (q->blocks && l && l->hrtf_frames != frames) {
+		pthread_mutex_unlock(&q->mutex);
+		goto fail;
+	}
+
+	/* The tables replaced before the last audio block started. */
+	for (p = &q->retired; *p; ) {
+		l = *p;
+		if (l->block < q->blocks) {
+			*p = l->next;
+			l->next = done;
+			done = l;
+		} else
+			p = &l->next;
+	}
+
+	/* A table still queued was never used. */
+	if (q->pending) {
+		q->pending->next = done;
+		done = q->pending;
+		q->pending = NULL;
+	}
+
+	if (q->blocks) {
+		q->pending = lookup;
+	} else {
+		/* No audio block started yet: switch at once. */
+		if (aave->hrtf_lookup) {
+			aave->hrtf_lookup->next = done;
+			done = aave->hrtf_lookup;
+		}
+		aave->hrtf_lookup = lookup;
+		aave->hrtf_get = hrtf_get;
+		aave->hrtf_file = file;
+		aave->hrtf_frames = frames;
+	}
+
+	pthread_mutex_unlock(&q->mutex);
+
+	while (done) {
+		l = done->next;
+		aave_hrtf_lookup_free_table(done);
+		done = l;
+	}
+	return 0;
+
+fail:
+	/* The caller still owns the file. */
+	lookup->hrtf_file = NULL;
+	aave_hrtf_lookup_free_table(lookup);
+	return -1;
+}
+
+/**
+ * Switch the auralisation world @p aave to the HRTF set selected last, if
+ * any, at the start of an audio block. This is called by the audio thread,
+ * which, after its first block, skips the switch if a set is being
+ * selected.
+ */
+void aave_hrtf_lookup_apply(struct aave *aave)
+{
+	struct aave_hrtf_queue *q = aave->hrtf_queue;
+	struct aave_hrtf_lookup *lookup;
+
+	/* Only the audio thread changes the count. */
+	if (!q->blocks)
+		pthread_mutex_lock(&q->mutex);
+	else if (pthread_mutex_trylock(&q->mutex))
+		return;
+	q->blocks++;
+	lookup = q->pending;
+
+	/* A set with delays waits until the sounds have their right ear. */
+	if (lookup && lookup->hrtf_file && lookup->hrtf_file->delays
+	    && __atomic_load_n(&aave->hrtf_delays, __ATOMIC_ACQUIRE)
+						!= AAVE_HRTF_DELAYS_READY)
+		lookup = NULL;
+
+	if (lookup) {
+		/* The sounds still crossfade from it in this block. */
+		aave->hrtf_lookup->block = q->blocks;
+		aave->hrtf_lookup->next = q->retired;
+		q->retired = aave->hrtf_lookup;
+
+		aave->hrtf_lookup = lookup;
+		aave->hrtf_get = lookup->hrtf_get;
+		aave->hrtf_file = lookup->hrtf_file;
+		aave->hrtf_frames = lookup->hrtf_frames;
+		q->pending = NULL;
+	}
+	pthread_mutex_unlock(&q->mutex);
+}
+
+/**
+ * Calculate the Ambisonics decoder of the HRTF sets of the auralisation
+ * world @p aave in use and queued, if they have none, when the Ambisonics
+ * mode is first selected (see aave_set_render()). The sets selected later
+ * get theirs with the direction lookup table. This must be called from
+ * the thread that selects the HRTF sets.
+ * Returns 0 on success, or -1 if out of memory.
+ */
+int aave_hrtf_lookup_decoder(struct aave *aave)
+{
+	struct aave_hrtf_queue *q = aave->hrtf_queue;
+	struct aave_hrtf_lookup *lookup[2];
+	unsigned i;
+
+	if (!q)
+		return 0;
+
+	/* Only this thread releases them, so they outlive the lock. */
+	pthread_mutex_lock(&q->mutex);
+	lookup[0] = aave->hrtf_lookup;
+	lookup[1] = q->pending;
+	pthread_mutex_unlock(&q->mutex);
+
+	for (i = 0; i < 2; i++)
+		if (lookup[i] && !lookup[i]->decoder
+		    && aave_ambisonics_decoder(aave, lookup[i]))
+			return -1;
+
+	return 0;
+}
+
+/**
+ * Release the HRTF sets of the auralisation world @p aave, their direction
+ * lookup tables and HRTF files, when the audio is stopped.
+ */
+void aave_hrtf_lookup_free(struct aave *aave)
+{
+	struct aave_hrtf_queue *q = aave->hrtf_queue;
+	struct aave_hrtf_lookup *l;
+
+	if (!q)
+		return;
+
+	if (q->pending)
+		aave_hrtf_lookup_free_table(q->pending);
+	while (q->retired) {
+		l = q->retired->next;
+		aave_hrtf_lookup_free_table(q->retired);
+		q->retired = l;
+	}
+	if (aave->hrtf_lookup)
+		aave_hrtf_lookup_free_table(aave->hrtf_lookup);
+	pthread_mutex_destroy(&q->mutex);
+	free(q);
+
+	aave->hrtf_queue = NULL;
+	aave->hrtf_lookup = NULL;
+	aave->hrtf_get = NULL;
+	aave->hrtf_file = NULL;
+}
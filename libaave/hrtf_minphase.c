@@ -0,0 +1,147 @@
+/*   This file is part of LibAAVE.
+ * 
+ *   LibAAVE is free software: you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation, either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   LibAAVE is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with LibAAVE.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *   Copyright 2014 André Oliveira, Nuno Silva, Guilherme Campos,
+ *   Paulo Dias, José Vieira/IEETA - Universidade de Aveiro
+ *
+ *
+ *   libaave/hrtf_minphase.c: minimum-phase decomposition of HRTFs
+ */
+
+/**
+ * @file hrtf_minphase.c
+ *
+ * The hrtf_minphase.c file decomposes an HRTF into a minimum-phase HRTF
+ * and a pure delay. Most of the length of the measured HRIRs, and thus of
+ * the cost of the convolution and of the latency of the HRTF audio blocks
+ * (aave->hrtf_frames), is the delay of the onset, different for each ear,
+ * and the sparse tail after it: the minimum-phase HRTF, with the same
+ * magnitude, has its energy at the start, and can be truncated to 128 or
+ * 256 frames with little loss, while the delay is applied with the
+ * resampler of audio.c (see the delays of the HRTF files in hrtf_file.c).
+ *
+ * The minimum-phase HRTF is calculated with the folded real cepstrum of
+ * the magnitude of the HRTF: the cepstrum of a minimum-phase signal is
+ * causal, so folding the negative quefrencies of the real cepstrum onto
+ * the positive ones, and going back to the frequency domain with the
+ * complex exponential, gives a signal with the same magnitude and minimum
+ * phase (A. V. Oppenheim, R. W. Schafer, "Discrete-Time Signal Processing",
+ * section 12.3). The delay is the lag of the peak of the cross-correlation
+ * of the HRTF and its minimum-phase version, with parabolic interpolation.
+ *
+ * This is used offline, by the tools that write HRTF files
+ * (tools/hrtf_file.c and tools/hrtf_sofa.c), not in the audio processing.
+ */
+
+#include <math.h>
+#include "aave.h"
+
+/**
+ * Create the dft() function to convert the cepstrum and the truncated
+ * HRIR to Fourier coefficients.
+ */
+#define DFT_TYPE float
+#include "dft.h"
+
+/**
+ * Create the idft() function to convert the log magnitude and the
+ * minimum-phase HRTF to the time domain.
+ */
+#define IDFT_TYPE float
+#include "idft.h"
+
+/** Floor of the magnitude, relative to its maximum (-120 dB). */
+#define AAVE_MINPHASE_FLOOR 1e-6
+
+/**
+ * Decompose the HRTF @p x of @p frames frames (4 * @p frames floats, in the
+ * layout of dft.h) into a minimum-phase HRTF of @p length frames, stored
+ * in @p y (4 * @p length floats), and a pure delay, which is returned,
+ * in samples. @p length must be a power of 2, up to @p frames. The last
+ * quarter of the minimum-phase HRIR is faded out with a half Hann window.
+ */
+float aave_hrtf_minimum_phase(float *y, unsigned length, const float *x,
+							unsigned frames)
+{
+	float c[AAVE_MAX_HRTF * 4], h[AAVE_MAX_HRTF * 4];
+	float r[AAVE_MAX_HRTF * 4];
+	float m, e, p, q, a;
+	unsigned i, n = frames * 4, k;
+
+	/* Floor of the magnitude, to keep its logarithm finite. */
+	e = x[0] * x[0] > x[1] * x[1] ? x[0] * x[0] : x[1] * x[1];
+	for (i = 2; i < n; i += 2) {
+		m = x[i] * x[i] + x[i + 1] * x[i + 1];
+		if (m > e)
+			e = m;
+	}
+	e = e * (AAVE_MINPHASE_FLOOR * AAVE_MINPHASE_FLOOR) + 1e-30;
+
+	/* Real cepstrum: IDFT of the log magnitude. */
+	c[0] = 0.5 * log(x[0] * x[0] > e ? x[0] * x[0] : e);
+	c[1] = 0.5 * log(x[1] * x[1] > e ? x[1] * x[1] : e);
+	for (i = 2; i < n; i += 2) {
+		m = x[i] * x[i] + x[i + 1] * x[i + 1];
+		c[i] = 0.5 * log(m > e ? m : e);
+		c[i + 1] = 0;
+	}
+	idft(r, c, n);
+
+	/* Fold the negative quefrencies (dft() reads the first half). */
+	for (i = 1; i < n / 2; i++)
+		r[i] *= 2;
+	dft(h, r, n);
+
+	/* Minimum-phase HRTF: complex exponential. */
+	h[0] = exp(h[0]);
+	h[1] = exp(h[1]);
+	for (i = 2; i < n; i += 2) {
+		m = exp(h[i]);
+		a = h[i + 1];
+		h[i] = m * cos(a);
+		h[i + 1] = m * sin(a);
+	}
+
+	/* Cross-correlation of the HRTF and the minimum-phase HRTF. */
+	c[0] = x[0] * h[0];
+	c[1] = x[1] * h[1];
+	for (i = 2; i < n; i += 2) {
+		c[i] = x[i] * h[i] + x[i + 1] * h[i + 1];
+		c[i + 1] = x[i + 1] * h[i] - x[i] * h[i + 1];
+	}
+	idft(r, c, n);
+
+	/* Lag of its peak, within +-n / 2, interpolated. */
+	k = 0;
+	for (i = 1; i < n; i++)
+		if (r[i] > r[k])
+			k = i;
+	p = r[(k + n - 1) % n];
+	q = r[(k + 1) % n];
+	a = p - 2 * r[k] + q;
+	a = a < 0 ? 0.5 * (p - q) / a : 0;
+	a += k < n / 2 ? (float)k : (float)k - n;
+
+	/* Minimum-phase HRIR, truncated and faded out. */
+	idft(c, h, n);
+	for (i = length * 3 / 4; i < length; i++)
+		c[i] *= 0.5 + 0.5 * cos(M_PI * (i - length * 3 / 4.)
+							/ (length / 4.));
+	for (; i < length * 2; i++)
+		c[i] = 0;
+	dft(y, c, length * 4);
+
+	return a;
+}
@@ -59,7 +59,8 @@ extern const float hrtf_mit_set[][2][512];
  * @p elevation is [-90;90] degrees. @p azimuth is [-180;180] degrees.
  * @p hrtf[0] will be the left HRTF, @p hrtf[1] the right HRTF.
  */
-static void aave_hrtf_mit_get(const float *hrtf[2], int elevation, int azimuth)
+static void aave_hrtf_mit_get(const struct aave *aave, const float *hrtf[2],
+				int elevation, int azimuth)
 {
 	int a;
 	unsigned i;
@@ -105,11 +106,10 @@ static void aave_hrtf_mit_get(const float *hrtf[2], int elevation, int azimuth)
 }
 
 /**
- * Select the MIT KEMAR HRTF compact set for the auralisation process.
+ * Select the MIT KEMAR HRTF compact set for the auralisation process
+ * (see aave_hrtf_lookup_init()).
  */
 void aave_hrtf_mit(struct aave *a)
 {
-	a->hrtf_frames = 128;
-	a->hrtf_get = aave_hrtf_mit_get;
-	a->hrtf_output_buffer_index = 0;
+	aave_hrtf_lookup_init(a, aave_hrtf_mit_get, 0, 128);
 }
@@ -54,7 +54,8 @@ extern const float hrtf_tub_set[720][4096];
  * @p elevation is [-90;90] degrees. @p azimuth is [-180;180] degrees.
  * @p hrtf[0] will be the left HRTF, @p hrtf[1] the right HRTF.
  */
-static void aave_hrtf_tub_get(const float *hrtf[2], int elevation, int azimuth)
+static void aave_hrtf_tub_get(const struct aave *aave, const float *hrtf[2],
+				int elevation, int azimuth)
 {
 	azimuth = -azimuth;
 	if (azimuth < 0)
@@ -64,11 +65,10 @@ static void aave_hrtf_tub_get(const float *hrtf[2], int elevation, int azimuth)
 }
 
 /**
- * Select the TU-Berlin HRTF set for the auralisation process.
+ * Select the TU-Berlin HRTF set for the auralisation process
+ * (see aave_hrtf_lookup_init()).
  */
 void aave_hrtf_tub(struct aave *a)
 {
-	a->hrtf_frames = 1024;
-	a->hrtf_get = aave_hrtf_tub_get;
-	a->hrtf_output_buffer_index = 0;
+	aave_hrtf_lookup_init(a, aave_hrtf_tub_get, 0, 1024);
 }
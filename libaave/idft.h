@@ -46,64 +46,245 @@
  * @endcode
  * This will insert a static idft() function in your source code file that
  * transforms Fourier coefficients back into the corresponding integers.
+ *
+ * The idft() function performs all passes but the last in idft_passes().
+ * Code that needs to process the output data as it is generated, such
+ * as the output stage in audio.c, may include this file without defining
+ * IDFT_TYPE, to insert only idft_passes(), and implement the last pass.
+ *
+ * As in dft.h, the radix-4 passes use SSE butterflies when available,
+ * unless AAVE_DFT_SCALAR is defined or other butterflies are plugged in by
+ * defining IDFT_BUTTERFLY0() and IDFT_BUTTERFLY() before including this file.
  */
 
 /** Table with the pre-calculated sin() and cos() values. */
 extern const float dftsincos[][2];
 
+#ifndef IDFT_BUTTERFLY
 /**
- * This idft function calculates the @p n point inverse discrete Fourier
- * transform of the Fourier coefficients pointed by @p X
- * and stores the real output data in @p x.
- * @p X points to @p n elements, which correspond to the Fourier
- * coefficients 0 to @p n / 2, in the order described in dft.h.
- * @p x points to @p n elements correctly ordered.
+ * Radix-2 butterfly of idft() of the complex values @p a and @p b,
+ * without twiddle factor (first block of each pass).
  */
-static void idft(IDFT_TYPE *x, float *X, unsigned n)
+#define IDFT_BUTTERFLY0(a, b) do {					\
+		float f0 = (a).real, f1 = (a).imag;			\
+		float f2 = (b).real, f3 = (b).imag;			\
+		(a).real = f0 + f1;					\
+		(a).imag = 2 * f2;					\
+		(b).real = f0 - f1;					\
+		(b).imag = - 2 * f3;					\
+	} while (0)
+
+/**
+ * Radix-2 butterfly of idft() of the complex values @p a and @p b,
+ * with the twiddle factor @p cosx, @p sinx.
+ */
+#define IDFT_BUTTERFLY(a, b, cosx, sinx) do {				\
+		float f0 = (a).real, f1 = (a).imag;			\
+		float f2 = (b).real, f3 = (b).imag;			\
+		float f4 = f0 - f2;					\
+		float f5 = f1 + f3;					\
+		(a).real = f0 + f2;					\
+		(a).imag = f1 - f3;					\
+		(b).real = f4 * (cosx) - f5 * (sinx);			\
+		(b).imag = f5 * (cosx) + f4 * (sinx);			\
+	} while (0)
+
+#if defined(__SSE__) && !defined(AAVE_DFT_SCALAR)
+#define IDFT_SSE
+#include <xmmintrin.h> /* _mm_add_ps() */
+
+/**
+ * IDFT_BUTTERFLY0() of the 2 consecutive complex values in each of the SSE
+ * registers @p a and @p b; @p sign holds the sign bits of the imaginary
+ * parts (_mm_setr_ps(0, -0.f, 0, -0.f)).
+ */
+#define IDFT_BUTTERFLY0_SSE(a, b, sign) do {				\
+		__m128 v0 = _mm_shuffle_ps(a, a, _MM_SHUFFLE(2, 2, 0, 0)); \
+		__m128 v1 = _mm_shuffle_ps(a, a, _MM_SHUFFLE(3, 3, 1, 1)); \
+		__m128 v2 = _mm_add_ps(v0, _mm_xor_ps(v1, sign));	\
+		__m128 v3 = _mm_mul_ps(b, _mm_setr_ps(2, -2, 2, -2));	\
+		v0 = _mm_shuffle_ps(v2, v3, _MM_SHUFFLE(2, 0, 2, 0));	\
+		v1 = _mm_shuffle_ps(v2, v3, _MM_SHUFFLE(3, 1, 3, 1));	\
+		(a) = _mm_shuffle_ps(v0, v0, _MM_SHUFFLE(3, 1, 2, 0));	\
+		(b) = _mm_shuffle_ps(v1, v1, _MM_SHUFFLE(3, 1, 2, 0));	\
+	} while (0)
+
+/**
+ * IDFT_BUTTERFLY() of the 2 consecutive complex values in each of the SSE
+ * registers @p a and @p b, with the twiddle factor @p cosx (in all lanes)
+ * and @p sinx (with the sign of the real parts flipped); @p sign as in
+ * IDFT_BUTTERFLY0_SSE().
+ */
+#define IDFT_BUTTERFLY_SSE(a, b, cosx, sinx, sign) do {		\
+		__m128 v0 = _mm_xor_ps(b, sign);			\
+		__m128 v1 = _mm_sub_ps(a, v0);				\
+		(a) = _mm_add_ps(a, v0);				\
+		(b) = _mm_add_ps(_mm_mul_ps(v1, cosx),			\
+			_mm_mul_ps(_mm_shuffle_ps(v1, v1,		\
+				_MM_SHUFFLE(2, 3, 0, 1)), sinx));	\
+	} while (0)
+
+/**
+ * Perform one radix-4 pass of idft_passes() (the radix-2 stages of blocks
+ * of 2 * @p m and 4 * @p m complex values) of the @p n point IDFT pointed
+ * by @p X, for @p m > 1, with the SSE butterflies.
+ */
+static void idft_pass_sse(float *X, unsigned m, unsigned n)
+{
+	const __m128 sign = _mm_setr_ps(0, -0.f, 0, -0.f);
+	__m128 a0, a1, a2, a3, c0, s0, c1, s1, c2, s2;
+	float *X0 = X, *X1 = X + m * 2, *X2 = X + m * 4, *X3 = X + m * 6;
+	unsigned i, j, k;
+
+	/* Offsets in floats: m complex values are 2 * m floats. */
+	c0 = _mm_set1_ps(dftsincos[0][1]);
+	s0 = _mm_setr_ps(-dftsincos[0][0], dftsincos[0][0],
+				-dftsincos[0][0], dftsincos[0][0]);
+	for (k = 0; k < m * 2; k += 4) {
+		a0 = _mm_loadu_ps(X0 + k);
+		a1 = _mm_loadu_ps(X1 + k);
+		a2 = _mm_loadu_ps(X2 + k);
+		a3 = _mm_loadu_ps(X3 + k);
+		IDFT_BUTTERFLY0_SSE(a0, a1, sign);
+		IDFT_BUTTERFLY_SSE(a2, a3, c0, s0, sign);
+		IDFT_BUTTERFLY0_SSE(a0, a2, sign);
+		IDFT_BUTTERFLY0_SSE(a1, a3, sign);
+		_mm_storeu_ps(X0 + k, a0);
+		_mm_storeu_ps(X1 + k, a1);
+		_mm_storeu_ps(X2 + k, a2);
+		_mm_storeu_ps(X3 + k, a3);
+	}
+	j = 0;
+	for (i = 8 * m; i < n; i += 8 * m) {
+		c1 = _mm_set1_ps(dftsincos[2*j+1][1]);
+		s1 = _mm_setr_ps(-dftsincos[2*j+1][0], dftsincos[2*j+1][0],
+				-dftsincos[2*j+1][0], dftsincos[2*j+1][0]);
+		c2 = _mm_set1_ps(dftsincos[2*j+2][1]);
+		s2 = _mm_setr_ps(-dftsincos[2*j+2][0], dftsincos[2*j+2][0],
+				-dftsincos[2*j+2][0], dftsincos[2*j+2][0]);
+		c0 = _mm_set1_ps(dftsincos[j][1]);
+		s0 = _mm_setr_ps(-dftsincos[j][0], dftsincos[j][0],
+					-dftsincos[j][0], dftsincos[j][0]);
+		j++;
+		for (k = i; k < i + m * 2; k += 4) {
+			a0 = _mm_loadu_ps(X0 + k);
+			a1 = _mm_loadu_ps(X1 + k);
+			a2 = _mm_loadu_ps(X2 + k);
+			a3 = _mm_loadu_ps(X3 + k);
+			IDFT_BUTTERFLY_SSE(a0, a1, c1, s1, sign);
+			IDFT_BUTTERFLY_SSE(a2, a3, c2, s2, sign);
+			IDFT_BUTTERFLY_SSE(a0, a2, c0, s0, sign);
+			IDFT_BUTTERFLY_SSE(a1, a3, c0, s0, sign);
+			_mm_storeu_ps(X0 + k, a0);
+			_mm_storeu_ps(X1 + k, a1);
+			_mm_storeu_ps(X2 + k, a2);
+			_mm_storeu_ps(X3 + k, a3);
+		}
+	}
+}
+#endif /* IDFT_SSE */
+#endif /* IDFT_BUTTERFLY */
+
+/**
+ * This idft_passes function performs all the passes of the @p n point
+ * inverse discrete Fourier transform of the Fourier coefficients pointed
+ * by @p X, in place, but the last one, IDFT N=n/4, which converts the
+ * complex values X[i] and X[i + n/4] (i < n/4) into the real output data
+ * x[i], x[i + n/4], x[i + n/2] and x[i + 3n/4] (see idft()).
+ *
+ * As in dft(), each pass performs two radix-2 stages at once (radix-4),
+ * unless AAVE_DFT_RADIX2 is defined before including this file.
+ */
+static void idft_passes(float *X, unsigned n)
 {
 	struct complex { float real; float imag; } *X0, *X1;
-	IDFT_TYPE *x0, *x1, *x2, *x3;
 	unsigned i, j, k, m;
-	float f0, f1, f2, f3, f4, f5;
 	float sinx, cosx;
+#ifndef AAVE_DFT_RADIX2
+	struct complex *X2, *X3;
+	float cos1, sin1, cos2, sin2;
+#endif
 
 	X0 = (struct complex *)X;
+	m = 1;
 
-	/* IDFT N=2, N=4, ... , N=n/4 */
-	for (m = 1; m < n / 4; m *= 2) {
-		X1 = (struct complex *)X + m;
-		for (i = 0; i < m; i++) {
-			f0 = X0[i].real;
-			f1 = X0[i].imag;
-			f2 = X1[i].real;
-			f3 = X1[i].imag;
-			X0[i].real = f0 + f1;
-			X0[i].imag = 2 * f2;
-			X1[i].real = f0 - f1;
-			X1[i].imag = - 2 * f3;
+#ifndef AAVE_DFT_RADIX2
+	/* IDFT N=2 and N=4, N=8 and N=16, ... , 2 stages per pass */
+	for ( ; m * 2 < n / 4; m *= 4) {
+#ifdef IDFT_SSE
+		if (m > 1) {
+			idft_pass_sse(X, m, n);
+			continue;
+		}
+#endif
+		X1 = X0 + m;
+		X2 = X0 + m * 2;
+		X3 = X0 + m * 3;
+		sinx = dftsincos[0][0];
+		cosx = dftsincos[0][1];
+		for (k = 0; k < m; k++) {
+			IDFT_BUTTERFLY0(X0[k], X1[k]);
+			IDFT_BUTTERFLY(X2[k], X3[k], cosx, sinx);
+			IDFT_BUTTERFLY0(X0[k], X2[k]);
+			IDFT_BUTTERFLY0(X1[k], X3[k]);
+		}
+		j = 0;
+		for (i = 4 * m; i < n / 2; i += 4 * m) {
+			sin1 = dftsincos[2*j+1][0];
+			cos1 = dftsincos[2*j+1][1];
+			sin2 = dftsincos[2*j+2][0];
+			cos2 = dftsincos[2*j+2][1];
+			sinx = dftsincos[j][0];
+			cosx = dftsincos[j][1];
+			j++;
+			for (k = i; k < i + m; k++) {
+				IDFT_BUTTERFLY(X0[k], X1[k], cos1, sin1);
+				IDFT_BUTTERFLY(X2[k], X3[k], cos2, sin2);
+				IDFT_BUTTERFLY(X0[k], X2[k], cosx, sinx);
+				IDFT_BUTTERFLY(X1[k], X3[k], cosx, sinx);
+			}
 		}
+	}
+#endif
+
+	/* IDFT N=2, N=4, ... , N=n/4, 1 stage per pass */
+	for ( ; m < n / 4; m *= 2) {
+		X1 = (struct complex *)X + m;
+		for (i = 0; i < m; i++)
+			IDFT_BUTTERFLY0(X0[i], X1[i]);
 		j = 0;
 		while ((i += m) < n / 2) {
 			sinx = dftsincos[j][0];
 			cosx = dftsincos[j][1];
 			j++;
 			for (k = 0; k < m; k++) {
-				f0 = X0[i].real;
-				f1 = X0[i].imag;
-				f2 = X1[i].real;
-				f3 = X1[i].imag;
-				f4 = f0 - f2;
-				f5 = f1 + f3;
-				X0[i].real = f0 + f2;
-				X0[i].imag = f1 - f3;
-				X1[i].real = f4 * cosx - f5 * sinx;
-				X1[i].imag = f5 * cosx + f4 * sinx;
+				IDFT_BUTTERFLY(X0[i], X1[i], cosx, sinx);
 				i++;
 			}
 		}
 	}
+}
+
+#ifdef IDFT_TYPE
+/**
+ * This idft function calculates the @p n point inverse discrete Fourier
+ * transform of the Fourier coefficients pointed by @p X
+ * and stores the real output data in @p x.
+ * @p X points to @p n elements, which correspond to the Fourier
+ * coefficients 0 to @p n / 2, in the order described in dft.h.
+ * @p x points to @p n elements correctly ordered.
+ */
+static void idft(IDFT_TYPE *x, float *X, unsigned n)
+{
+	struct complex { float real; float imag; } *X0, *X1;
+	IDFT_TYPE *x0, *x1, *x2, *x3;
+	unsigned i;
+	float f0, f1, f2, f3, f4, f5;
+
+	idft_passes(X, n);
 
 	/* IDFT N=n/4 */
+	X0 = (struct complex *)X;
 	x0 = x;
 	x1 = x + n / 4;
 	x2 = x + n / 2;
@@ -122,3 +303,4 @@ static void idft(IDFT_TYPE *x, float *X, unsigned n)
 		x3[i] = (f5 + f3) / n;
 	}
 }
+#endif
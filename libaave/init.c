@@ -32,10 +32,15 @@
 #include "stdio.h"
 
 /**
- * Initialise a sound source data structure to be used by the aave engine.
+ * Initialise a sound source data structure to be used by the aave engine,
+ * with the ring buffer its samples are put in (see aave_put_audio()).
+ * Returns 0 on success, or -1 if out of memory.
  */
-void aave_init_source(struct aave *aave, struct aave_source *source)
+int aave_init_source(struct aave *aave, struct aave_source *source)
 {
 	memset(source, 0, sizeof *source);
 	source->aave = aave;
+	source->silence = AAVE_SOURCE_BUFSIZE;
+
+	return aave_alloc_source_buffer(source) ? 0 : -1;
 }
@@ -41,7 +41,7 @@
  * Section 5.3.3 Filter Design by Frequency Sampling.
  */
 
-#include <math.h>	/* M_PI, cos(), sin() */
+#include <math.h>	/* M_PI, cos(), sin(), sqrt() */
 #include <string.h>	/* strcmp() */
 #include <stdio.h>
 #include "aave.h"
@@ -156,6 +156,16 @@ static void print_vec(const float *y, unsigned n)
 #define print_vec(h,n)
 #endif
 
+/**
+ * Level, relative to the peak of the material absorption filter, below
+ * which the filter is considered negligible (-30dB),
+ * in aave_get_material_stride().
+ */
+#define AAVE_MATERIAL_STRIDE_LEVEL 0.0316
+
+/** Maximum stride returned by aave_get_material_stride(). */
+#define AAVE_MATERIAL_MAX_STRIDE 8
+
 /**
  * Design the material absorption filter for the reflection factors @p k.
  * The calculated DFT coefficients of the filter are stored in @p x, which
@@ -233,17 +243,13 @@ static void aave_material_filter(const float *k, float *x, unsigned n)
 }
 
 /**
- * Design the material absorption filter for the specified sequence of
- * @p surfaces and reflection order @p reflections. The calculated DFT
- * coefficients of the filter are stored in @p filter, which must have
- * 4 times the elements of the HRIRs of the HRTF set currently in use.
+ * Calculate the total reflection factors @p k of the specified sequence of
+ * @p surfaces and reflection order @p reflections.
  */
-void aave_get_material_filter(struct aave *aave,
-				struct aave_surface **surfaces,
+static void aave_material_factors(struct aave_surface **surfaces,
 				unsigned reflections,
-				float *filter)
+				float k[AAVE_MATERIAL_REFLECTION_FACTORS])
 {
-	float k[AAVE_MATERIAL_REFLECTION_FACTORS];
 	const unsigned char *c;
 	unsigned i, j;
 
@@ -257,7 +263,91 @@ void aave_get_material_filter(struct aave *aave,
 		for (j = 0; j < AAVE_MATERIAL_REFLECTION_FACTORS; j++)
 			k[j] *= c[j] * 0.01;
 	}
+}
+
+/**
+ * Design the material absorption filter for the specified sequence of
+ * @p surfaces and reflection order @p reflections. The calculated DFT
+ * coefficients of the filter are stored in @p filter, which must have
+ * 4 times the elements of the HRIRs of the HRTF set currently in use,
+ * in the storage type of the spectra (see aave_spectrum).
+ */
+void aave_get_material_filter(struct aave *aave,
+				struct aave_surface **surfaces,
+				unsigned reflections,
+				aave_spectrum *filter)
+{
+	float k[AAVE_MATERIAL_REFLECTION_FACTORS];
+	float x[AAVE_MAX_HRTF * 4];
+
+	aave_material_factors(surfaces, reflections, k);
 
 	/* Generate a filter for hrtf_frames in the frequency domain. */
-	aave_material_filter(k, filter, aave->hrtf_frames);
+	aave_material_filter(k, x, aave->hrtf_frames);
+	aave_spectrum_store(filter, x, aave->hrtf_frames * 4);
+}
+
+/**
+ * Return the average (root mean square over the frequency bands) gain of
+ * the material absorption filter for the specified sequence of
+ * @p surfaces and reflection order @p reflections.
+ * It is used to estimate the level of the sounds, without having
+ * to look at the Fourier coefficients of the filter.
+ */
+float aave_get_material_gain(struct aave_surface **surfaces,
+							unsigned reflections)
+{
+	float k[AAVE_MATERIAL_REFLECTION_FACTORS], e;
+	unsigned i;
+
+	aave_material_factors(surfaces, reflections, k);
+
+	e = 0;
+	for (i = 0; i < AAVE_MATERIAL_REFLECTION_FACTORS; i++)
+		e += k[i] * k[i];
+
+	return sqrt(e / AAVE_MATERIAL_REFLECTION_FACTORS);
+}
+
+/**
+ * Return the stride s (1, 2, 4 or 8) of the band-limited processing of the
+ * sounds for the specified sequence of @p surfaces and reflection order
+ * @p reflections. The material absorption filter is negligible (below
+ * AAVE_MATERIAL_STRIDE_LEVEL times its peak) above 1 / s of the band,
+ * so the sound needs only the lowest 1 / s of its Fourier coefficients.
+ */
+unsigned aave_get_material_stride(struct aave_surface **surfaces,
+							unsigned reflections)
+{
+	/* upper limits for frequency bands */
+	static const unsigned short fc[AAVE_MATERIAL_REFLECTION_FACTORS] = {
+		177, 355, 710, 1420, 2840, 5680, 11360
+	};
+	float k[AAVE_MATERIAL_REFLECTION_FACTORS], max;
+	unsigned i, j, s;
+
+	aave_material_factors(surfaces, reflections, k);
+
+	max = 0;
+	for (i = 0; i < AAVE_MATERIAL_REFLECTION_FACTORS; i++)
+		if (k[i] > max)
+			max = k[i];
+
+	/* Find the highest band that is not negligible. */
+	j = AAVE_MATERIAL_REFLECTION_FACTORS - 1;
+	while (j > 0 && k[j] < max * AAVE_MATERIAL_STRIDE_LEVEL)
+		j--;
+
+	/*
+	 * The filter magnitude is interpolated up to the next band,
+	 * and is flat above the last one.
+	 */
+	if (j >= AAVE_MATERIAL_REFLECTION_FACTORS - 2)
+		return 1;
+
+	for (s = 1; s < AAVE_MATERIAL_MAX_STRIDE; s *= 2)
+		if (AAVE_FS / 2 / (s * 2) < fc[j + 1])
+			break;
+
+	return s;
 }
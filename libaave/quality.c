@@ -0,0 +1,283 @@
+/*   This file is part of LibAAVE.
+ * 
+ *   LibAAVE is free software: you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation, either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   LibAAVE is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with LibAAVE.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *   Copyright 2014 André Oliveira, Nuno Silva, Guilherme Campos,
+ *   Paulo Dias, José Vieira/IEETA - Universidade de Aveiro
+ *
+ *
+ *   libaave/quality.c: adaptive quality controller
+ */
+
+/**
+ * @file quality.c
+ *
+ * The quality.c file implements a feedback controller that adapts the
+ * amount of auralisation work to the processor the library is running on.
+ *
+ * The time spent in aave_get_audio() and aave_update() is measured and
+ * compared to the duration of the audio produced (the real-time deadline).
+ * At the end of each control period of AAVE_QUALITY_PERIOD seconds of
+ * audio, if the processing load is above the target load set with
+ * aave_quality(), the quality is lowered one step; if it is below the
+ * target by more than AAVE_QUALITY_HYSTERESIS, it is raised one step.
+ * An HRTF block that misses its deadline lowers the quality at once: the
+ * time of the calls of aave_get_audio() is accumulated until they produce
+ * the 2 * hrtf_frames frames of an HRTF block, and compared to their
+ * duration, since only one of the calls renders the block when the calls
+ * are shorter than it.
+ *
+ * Lowering the quality first shrinks the render budget aave->max_sounds,
+ * so that only the quietest sounds are lost, and when it reaches
+ * AAVE_QUALITY_MIN_SOUNDS, halves the order of the FDN of the Jot late
+ * reverberation down to AAVE_QUALITY_MIN_REVERB_ORDER, if it is the engine
+ * in use, and then lowers the order of reflections aave->reflections.
+ * Raising the quality takes the opposite steps, up to the order of
+ * reflections, FDN order and render budget set by the user when the
+ * controller was enabled.
+ *
+ * The controller runs on the audio thread, in aave_get_audio(): the time
+ * of aave_update() is only added to an accumulator, atomically, that the
+ * audio thread takes at its next call. The render budget is only used by
+ * the audio processing, and is changed right away. The FDN order is
+ * requested with aave_reverb_set_order(), which the reverberator applies
+ * before its next frames, and the order of reflections, whose changes walk
+ * the lists of sounds, is applied by the next call to aave_update() (see
+ * aave_quality_apply()), so that the sounds are only changed from the
+ * thread that updates the world.
+ */
+
+#include "aave.h"
+
+#ifdef _WIN32
+#include <windows.h> /* QueryPerformanceCounter() */
+#else
+#include <time.h> /* clock_gettime() */
+#endif
+
+/** Duration of the control period, in seconds of audio produced. */
+#define AAVE_QUALITY_PERIOD 0.5
+
+/**
+ * Fraction of the target load below which the quality is raised.
+ * With a target load of 0.7, the quality is raised below 0.7 * 0.75.
+ */
+#define AAVE_QUALITY_HYSTERESIS 0.25
+
+/** Smallest render budget the controller selects. */
+#define AAVE_QUALITY_MIN_SOUNDS 16
+
+/** Smallest order of the FDN of the Jot reverberator the controller selects. */
+#define AAVE_QUALITY_MIN_REVERB_ORDER 16
+
+/**
+ * Return the time, in seconds, of a monotonic clock.
+ */
+double aave_quality_clock(void)
+{
+#ifdef _WIN32
+	LARGE_INTEGER t, f;
+
+	QueryPerformanceCounter(&t);
+	QueryPerformanceFrequency(&f);
+
+	return (double)t.QuadPart / f.QuadPart;
+#else
+	struct timespec t;
+
+	clock_gettime(CLOCK_MONOTONIC, &t);
+
+	return t.tv_sec + t.tv_nsec * 1e-9;
+#endif
+}
+
+/**
+ * Return 1 if the FDN order of the late reverberation of the auralisation
+ * world @p aave is a quality step, that is, if the Jot reverberator is the
+ * engine in use, or 0 otherwise.
+ */
+static int aave_quality_reverb(const struct aave *aave)
+{
+	return __atomic_load_n(&aave->reverb_active, __ATOMIC_RELAXED)
+			&& aave->reverb
+			&& aave->reverb->engine == aave_reverb_jot;
+}
+
+/**
+ * Lower the quality of the auralisation world @p aave one step.
+ */
+static void aave_quality_down(struct aave *aave)
+{
+	struct aave_quality *q = &aave->quality;
+	unsigned n;
+
+	/* Shrink the render budget to 3/4 of the sounds rendered. */
+	n = q->sounds;
+	if (aave->max_sounds && aave->max_sounds < n)
+		n = aave->max_sounds;
+	if (n > AAVE_QUALITY_MIN_SOUNDS) {
+		n = n * 3 / 4;
+		aave->max_sounds = n > AAVE_QUALITY_MIN_SOUNDS ? n
+					: AAVE_QUALITY_MIN_SOUNDS;
+		return;
+	}
+
+	/* Halve the order of the FDN of the late reverberation. */
+	if (aave_quality_reverb(aave)
+	    && q->reverb_order > AAVE_QUALITY_MIN_REVERB_ORDER) {
+		q->reverb_order /= 2;
+		if (q->reverb_order < AAVE_QUALITY_MIN_REVERB_ORDER)
+			q->reverb_order = AAVE_QUALITY_MIN_REVERB_ORDER;
+		aave_reverb_set_order(aave, q->reverb_order);
+		return;
+	}
+
+	/* Lower the order of reflections (its sounds fade out). */
+	n = __atomic_load_n(&q->reflections, __ATOMIC_RELAXED);
+	if (n > 0)
+		__atomic_store_n(&q->reflections, n - 1, __ATOMIC_RELAXED);
+}
+
+/**
+ * Raise the quality of the auralisation world @p aave one step.
+ */
+static void aave_quality_up(struct aave *aave)
+{
+	struct aave_quality *q = &aave->quality;
+	unsigned n;
+
+	/* Raise the order of reflections. */
+	n = __atomic_load_n(&q->reflections, __ATOMIC_RELAXED);
+	if (n < q->max_reflections) {
+		__atomic_store_n(&q->reflections, n + 1, __ATOMIC_RELAXED);
+		return;
+	}
+
+	/* Double the order of the FDN of the late reverberation. */
+	if (aave_quality_reverb(aave) && q->reverb_order < q->max_reverb_order) {
+		q->reverb_order *= 2;
+		if (q->reverb_order > q->max_reverb_order)
+			q->reverb_order = q->max_reverb_order;
+		aave_reverb_set_order(aave, q->reverb_order);
+		return;
+	}
+
+	/* Grow the render budget, or lift it when it is no longer binding. */
+	if (aave->max_sounds != q->max_sounds) {
+		n = aave->max_sounds * 4 / 3 + 1;
+		if (q->sounds < aave->max_sounds
+		    || (q->max_sounds && n >= q->max_sounds))
+			aave->max_sounds = q->max_sounds;
+		else
+			aave->max_sounds = n;
+	}
+}
+
+/**
+ * Account @p seconds of processing time that produced @p frames of audio
+ * in the auralisation world @p aave, and adapt the quality accordingly.
+ * This is called by aave_get_audio() and aave_update() (with 0 frames)
+ * when the adaptive quality controller is enabled. The time of
+ * aave_update() is only added to @p aave->quality.update, and accounted
+ * by the next call of aave_get_audio(), which alone changes the quality.
+ */
+void aave_quality_account(struct aave *aave, double seconds, unsigned frames)
+{
+	struct aave_quality *q = &aave->quality;
+	int missed;
+
+	if (!frames) {
+		__atomic_fetch_add(&q->update, (unsigned long)(seconds * 1e6),
+							__ATOMIC_RELAXED);
+		return;
+	}
+
+	q->busy += seconds
+		+ __atomic_exchange_n(&q->update, 0, __ATOMIC_RELAXED) * 1e-6;
+	q->audio += (double)frames / AAVE_FS;
+
+	/* Missed the deadline of an HRTF block: lower the quality at once. */
+	q->block_busy += seconds;
+	q->block_frames += frames;
+	if (q->block_frames >= 2 * aave->hrtf_frames) {
+		missed = q->block_busy * AAVE_FS > q->block_frames;
+		q->block_busy = 0;
+		q->block_frames = 0;
+		if (missed) {
+			aave_quality_down(aave);
+			q->busy = 0;
+			q->audio = 0;
+			return;
+		}
+	}
+
+	if (q->audio < AAVE_QUALITY_PERIOD)
+		return;
+
+	q->load = q->busy / q->audio;
+	if (q->load > q->target)
+		aave_quality_down(aave);
+	else if (q->load < q->target * (1 - AAVE_QUALITY_HYSTERESIS))
+		aave_quality_up(aave);
+
+	q->busy = 0;
+	q->audio = 0;
+}
+
+/**
+ * Apply the order of reflections selected by the adaptive quality
+ * controller of the auralisation world @p aave. This is called by
+ * aave_update(), before it selects the order of reflections of the
+ * sources, when the controller is enabled.
+ */
+void aave_quality_apply(struct aave *aave)
+{
+	aave->reflections = __atomic_load_n(&aave->quality.reflections,
+							__ATOMIC_RELAXED);
+}
+
+/**
+ * Enable the adaptive quality controller of the auralisation world
+ * @p aave, to keep the processing load at @p target (the fraction of
+ * the real time spent processing, e.g. 0.7), or disable it if @p target
+ * is 0. The current order of reflections, FDN order of the late
+ * reverberation and render budget are the highest quality the controller
+ * will select, and are restored when it is disabled.
+ * This must be called from the thread that calls aave_update().
+ */
+void aave_quality(struct aave *aave, float target)
+{
+	struct aave_quality *q = &aave->quality;
+
+	if (q->target > 0) {
+		q->reflections = q->max_reflections;
+		q->reverb_order = q->max_reverb_order;
+		aave_quality_apply(aave);
+		if (aave->reverb && q->reverb_order)
+			aave_reverb_set_order(aave, q->reverb_order);
+		aave->max_sounds = q->max_sounds;
+	}
+
+	q->target = target;
+	q->load = 0;
+	q->busy = 0;
+	q->audio = 0;
+	q->block_busy = 0;
+	q->block_frames = 0;
+	q->update = 0;
+	q->max_reflections = q->reflections = aave->reflections;
+	q->max_reverb_order = q->reverb_order
+				= aave->reverb ? aave->reverb->order : 0;
+	q->max_sounds = aave->max_sounds;
+}
@@ -0,0 +1,452 @@
+/*   This file is part of LibAAVE.
+ * 
+ *   LibAAVE is free software: you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation, either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   LibAAVE is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with LibAAVE.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *   Copyright 2014 André Oliveira, Nuno Silva, Guilherme Campos,
+ *   Paulo Dias, José Vieira/IEETA - Universidade de Aveiro
+ *
+ *
+ *   libaave/reverb.c: late reverberation pipeline
+ */
+
+/**
+ * @file reverb.c
+ *
+ * The reverb.c file feeds the late reverberation engine of the auralisation
+ * world, selected with aave_reverb_set_engine() (reverb_jot.c,
+ * reverb_dattorro.c or reverb_conv.c), with the pre-delayed sum of the
+ * anechoic sound sources pointed by @p aave->sources, and mixes its output
+ * with the binaural frames generated by audio.c.
+ *
+ * Since the late reverberation is pre-delayed by at least the latency of
+ * the HRTF processing, the samples it needs for the next frames are in the
+ * ring buffers of the sources before those frames are requested.
+ * With aave_reverb_thread(), the reverberator runs on a worker thread, one
+ * call of aave_get_audio() ahead: at the end of each call, the input for as
+ * many frames as the call generated (as far as the pre-delay allows) is
+ * read from the sources and handed to the worker, which processes it while
+ * the next call renders the HRTF stage; that call then only mixes the
+ * frames the worker has ready, and processes any remaining ones inline.
+ * The audio thread never waits for the worker: if it is still busy when
+ * its frames are due, they are mixed without the reverberation tail, and
+ * dropped from its output when it is done, so that it stays in step.
+ *
+ * The worker thread uses POSIX threads (link with -lpthread).
+ */
+
+#include <pthread.h> /* pthread_create() */
+#include <stdlib.h> /* calloc() */
+#include <string.h> /* memmove() */
+#include "aave.h"
+
+/** Maximum number of frames the worker thread processes ahead. */
+#define AAVE_REVERB_AHEAD 8192
+
+/** Number of frames processed inline at a time. */
+#define AAVE_REVERB_CHUNK 1024
+
+/**
+ * Data of the worker thread of the late reverberation.
+ */
+struct aave_reverb_thread {
+
+	/** The worker thread. */
+	pthread_t thread;
+
+	/** Protects @p job and @p stop. */
+	pthread_mutex_t mutex;
+
+	/** Signals a change of @p job or @p stop. */
+	pthread_cond_t cond;
+
+	/** Set to stop the worker thread. */
+	int stop;
+
+	/** Number of frames handed to the worker, 0 when it is idle. */
+	unsigned job;
+
+	/** Index in @p y of the first frame ready. */
+	unsigned start;
+
+	/** Number of frames ready in @p y. */
+	unsigned ready;
+
+	/**
+	 * Number of frames of the job already mixed without their tail,
+	 * as the worker was late, to drop when it is done.
+	 */
+	unsigned late;
+
+	/** Total number of frames mixed without their tail. */
+	unsigned long missed;
+
+	/** Input of the frames handed to the worker. */
+	float x[AAVE_REVERB_AHEAD];
+
+	/** Reverberation tail of the frames ready, then of the job. */
+	float y[AAVE_REVERB_AHEAD * 2];
+};
+
+/**
+ * Return the pre-delay with which the input of the late reverberator of
+ * @p rev is read from the sources, in samples: that of the reverberation,
+ * less the delay the convolution reverberator adds, if selected.
+ */
+static unsigned aave_reverb_delay(const struct aave_reverb *rev)
+{
+	unsigned d = rev->pre_delay;
+
+	if (rev->engine == aave_reverb_conv)
+		d = d > AAVE_REVERB_CONV_BLOCK ? d - AAVE_REVERB_CONV_BLOCK : 0;
+
+	return d;
+}
+
+/**
+ * Store in @p x the sum of the @p n samples of the anechoic sound sources
+ * pointed by @p aave->sources, starting @p offset samples from the most
+ * recent one of each source (modulo 2^32).
+ */
+static void aave_reverb_input(struct aave *aave, float *x, unsigned offset,
+								unsigned n)
+{
+	struct aave_source *source;
+	unsigned k, t;
+
+	for (t = 0; t < n; t++)
+		x[t] = 0;
+	for (source = aave->sources; source; source = source->next) {
+		k = source->buffer_index + offset;
+		for (t = 0; t < n; t++)
+			x[t] += aave_source_sample(source, k + t);
+	}
+}
+
+/**
+ * Worker thread of the late reverberation of the auralisation world
+ * @p arg: process the frames handed by aave_reverb_ahead().
+ */
+static void *aave_reverb_worker(void *arg)
+{
+	struct aave_reverb *rev = ((struct aave *)arg)->reverb;
+	struct aave_reverb_thread *th = rev->thread;
+	unsigned n;
+	float *y;
+
+	pthread_mutex_lock(&th->mutex);
+	for (;;) {
+		while (!th->job && !th->stop)
+			pthread_cond_wait(&th->cond, &th->mutex);
+		if (th->stop)
+			break;
+		n = th->job;
+		y = th->y + (th->start + th->ready) * 2;
+		pthread_mutex_unlock(&th->mutex);
+
+		rev->engine(rev, th->x, y, n);
+
+		pthread_mutex_lock(&th->mutex);
+		th->ready += n;
+		th->job = 0;
+		pthread_cond_broadcast(&th->cond);
+	}
+	pthread_mutex_unlock(&th->mutex);
+
+	return NULL;
+}
+
+/**
+ * Wait until the worker thread of the late reverberation of the
+ * auralisation world @p aave, if running, is idle, so that the state of
+ * the reverberator can be used or changed.
+ */
+void aave_reverb_sync(struct aave *aave)
+{
+	struct aave_reverb_thread *th;
+
+	if (!aave->reverb || !aave->reverb->thread)
+		return;
+
+	th = aave->reverb->thread;
+	pthread_mutex_lock(&th->mutex);
+	while (th->job)
+		pthread_cond_wait(&th->cond, &th->mutex);
+	pthread_mutex_unlock(&th->mutex);
+}
+
+/**
+ * Return the number of frames of the job of the worker thread @p th, 0 if
+ * it is idle, without waiting for it. If it is idle, drop the frames it
+ * finished that were already mixed without their tail; otherwise, store
+ * in @p ready the number of frames that were ready before its job.
+ */
+static unsigned aave_reverb_busy(struct aave_reverb_thread *th,
+							unsigned *ready)
+{
+	unsigned job;
+
+	pthread_mutex_lock(&th->mutex);
+	job = th->job;
+	if (!job) {
+		/* The job is done, so its late frames are ready. */
+		th->start += th->late;
+		th->ready -= th->late;
+		th->late = 0;
+	} else {
+		*ready = th->late ? 0 : th->ready;
+	}
+	pthread_mutex_unlock(&th->mutex);
+
+	return job;
+}
+
+/**
+ * Add the @p n binaural frames of the reverberation tail @p z, scaled by
+ * @p scale, or none if @p z is NULL, to the frames of the left and right
+ * channels @p y[0] and @p y[1], @p stride samples apart, and apply the gain
+ * of the auralisation world @p aave.
+ */
+static void aave_reverb_mix(const struct aave *aave, float *y[2],
+		unsigned stride, const float *z, unsigned n, float scale)
+{
+	unsigned c, t;
+
+	for (c = 0; c < 2; c++) {
+		if (!z) {
+			for (t = 0; t < n; t++)
+				y[c][t * stride] *= aave->gain;
+			continue;
+		}
+		for (t = 0; t < n; t++)
+			y[c][t * stride] = (y[c][t * stride]
+					+ z[t * 2 + c] * scale) * aave->gain;
+	}
+}
+
+/**
+ * Add the late reverberation tail, scaled by @p scale, to the @p n
+ * binaural frames of the left and right channels @p y[0] and @p y[1],
+ * @p stride samples apart, @p delay frames before the last ones of the
+ * current call of aave_get_audio(), and apply the gain of the
+ * auralisation world @p aave.
+ * The frames the worker thread has ready are used first; if it is still
+ * busy with the following ones, these are mixed without the tail.
+ */
+void aave_reverb(struct aave *aave, float *y[2], unsigned stride,
+				unsigned n, unsigned delay, float scale)
+{
+	struct aave_reverb *rev = aave->reverb;
+	struct aave_reverb_thread *th = rev->thread;
+	float x[AAVE_REVERB_CHUNK], w[AAVE_REVERB_CHUNK * 2], *z, *p[2];
+	unsigned i = 0, k, t, job, ready;
+
+	if (th && (job = aave_reverb_busy(th, &ready))) {
+		/* The frames ready, then the late ones of the job, dry. */
+		k = n < ready ? n : ready;
+		aave_reverb_mix(aave, y, stride, th->y + th->start * 2, k,
+								scale);
+		p[0] = y[0] + k * stride;
+		p[1] = y[1] + k * stride;
+		aave_reverb_mix(aave, p, stride, NULL, n - k, scale);
+
+		pthread_mutex_lock(&th->mutex);
+		th->start += k;
+		th->ready -= k;
+		t = th->late + n - k;
+		th->late = t < job ? t : job;
+		th->missed += n - k;
+		pthread_mutex_unlock(&th->mutex);
+		return;
+	}
+
+	/* The worker is idle: apply the changes requested since. */
+	aave_reverb_apply(rev);
+
+	/* No engine: only the gain. */
+	if (!rev->engine) {
+		aave_reverb_mix(aave, y, stride, NULL, n, scale);
+		return;
+	}
+
+	while (i < n) {
+		if (th && th->ready) {
+			k = n - i < th->ready ? n - i : th->ready;
+			z = th->y + th->start * 2;
+			th->start += k;
+			th->ready -= k;
+		} else {
+			k = n - i < AAVE_REVERB_CHUNK ? n - i : AAVE_REVERB_CHUNK;
+			aave_reverb_input(aave, x,
+				i - n - delay - aave_reverb_delay(rev), k);
+			rev->engine(rev, x, w, k);
+			z = w;
+		}
+
+		p[0] = y[0] + i * stride;
+		p[1] = y[1] + i * stride;
+		aave_reverb_mix(aave, p, stride, z, k, scale);
+		i += k;
+	}
+}
+
+/**
+ * Apply the changes to the late reverberator @p rev requested since its
+ * last block: the order of the FDN, the convolution reverberator and the
+ * engine. This is called on the audio thread by aave_reverb() and
+ * aave_reverb_ahead(), when the worker thread, if any, is idle, so that
+ * the engine never changes under it.
+ */
+void aave_reverb_apply(struct aave_reverb *rev)
+{
+	unsigned engine;
+
+	/* The convolution reverberator is published before its engine. */
+	engine = __atomic_exchange_n(&rev->next_engine, 0, __ATOMIC_ACQUIRE);
+	aave_reverb_apply_order(rev);
+	aave_reverb_conv_apply(rev);
+
+	switch (engine) {
+	case AAVE_REVERB_NONE + 1:
+		rev->engine = NULL;
+		break;
+	case AAVE_REVERB_JOT + 1:
+		rev->engine = aave_reverb_jot;
+		break;
+	case AAVE_REVERB_DATTORRO + 1:
+		rev->engine = aave_reverb_dattorro;
+		break;
+	case AAVE_REVERB_CONV + 1:
+		if (rev->conv)
+			rev->engine = aave_reverb_conv;
+		break;
+	}
+}
+
+/**
+ * Hand the input of the @p n frames that follow the current call of
+ * aave_get_audio() to the worker thread of the late reverberation of the
+ * auralisation world @p aave, if running and idle, as far as they are
+ * already in the sources. This is called by aave_get_audio() after its
+ * last call to aave_reverb().
+ */
+void aave_reverb_ahead(struct aave *aave, unsigned n)
+{
+	struct aave_reverb_thread *th = aave->reverb->thread;
+	unsigned d;
+
+	if (!th || !n || aave_reverb_busy(th, &d))
+		return;
+	aave_reverb_apply(aave->reverb);
+	if (!aave->reverb->engine)
+		return;
+
+	/* Keep the frames ready, at the start. */
+	memmove(th->y, th->y + th->start * 2, th->ready * 2 * sizeof th->y[0]);
+	th->start = 0;
+
+	/* Frame ready + t needs the sample ready + t - d from the last one. */
+	d = aave_reverb_delay(aave->reverb);
+	if (th->ready >= d)
+		return;
+	if (n > d - th->ready)
+		n = d - th->ready;
+	if (n > AAVE_REVERB_AHEAD - th->ready)
+		n = AAVE_REVERB_AHEAD - th->ready;
+	if (!n)
+		return;
+
+	aave_reverb_input(aave, th->x, th->ready - d, n);
+
+	pthread_mutex_lock(&th->mutex);
+	th->job = n;
+	pthread_cond_signal(&th->cond);
+	pthread_mutex_unlock(&th->mutex);
+}
+
+/**
+ * Select the late reverberation engine @p engine (AAVE_REVERB_*) of the
+ * auralisation world @p aave. AAVE_REVERB_NONE deactivates the late
+ * reverberation, and the other engines activate it. AAVE_REVERB_CONV
+ * synthesises a late impulse response with aave_reverb_conv_init() if none
+ * was loaded with aave_reverb_conv_set_ir().
+ * The engine is only requested here: the audio thread selects it before
+ * the next frames it reverberates (see aave_reverb_apply()).
+ * Reverberation unit must already be initialized.
+ * Returns 0 on success, or -1 if the engine is unknown or out of memory.
+ */
+int aave_reverb_set_engine(struct aave *aave, unsigned engine)
+{
+	struct aave_reverb *rev = aave->reverb;
+
+	if (engine > AAVE_REVERB_CONV)
+		return -1;
+
+	/* One loaded, even if not swapped in yet, is used. */
+	if (engine == AAVE_REVERB_CONV
+	    && !__atomic_load_n(&rev->conv, __ATOMIC_RELAXED)
+	    && !__atomic_load_n(&rev->next_conv, __ATOMIC_RELAXED)
+	    && aave_reverb_conv_init(aave))
+		return -1;
+
+	__atomic_store_n(&rev->next_engine, engine + 1, __ATOMIC_RELEASE);
+	__atomic_store_n(&aave->reverb_active, engine != AAVE_REVERB_NONE,
+							__ATOMIC_RELAXED);
+	return 0;
+}
+
+/**
+ * Run the late reverberation of the auralisation world @p aave on a worker
+ * thread, one call of aave_get_audio() ahead, if @p on is not 0, or inline,
+ * after the HRTF stage of each call, otherwise (the default).
+ * Reverberation unit must already be initialized.
+ * Returns 0 on success, or -1 if the thread could not be started.
+ */
+int aave_reverb_thread(struct aave *aave, int on)
+{
+	struct aave_reverb *rev = aave->reverb;
+	struct aave_reverb_thread *th = rev->thread;
+
+	if (!on == !th)
+		return 0;
+
+	if (th) {
+		/* The frames ready are lost: the reverberator went past them. */
+		pthread_mutex_lock(&th->mutex);
+		th->stop = 1;
+		pthread_cond_broadcast(&th->cond);
+		pthread_mutex_unlock(&th->mutex);
+		pthread_join(th->thread, NULL);
+		pthread_cond_destroy(&th->cond);
+		pthread_mutex_destroy(&th->mutex);
+		rev->thread = NULL;
+		free(th);
+		return 0;
+	}
+
+	th = calloc(1, sizeof *th);
+	if (!th)
+		return -1;
+	pthread_mutex_init(&th->mutex, NULL);
+	pthread_cond_init(&th->cond, NULL);
+	rev->thread = th;
+	if (pthread_create(&th->thread, NULL, aave_reverb_worker, aave)) {
+		pthread_cond_destroy(&th->cond);
+		pthread_mutex_destroy(&th->mutex);
+		rev->thread = NULL;
+		free(th);
+		return -1;
+	}
+
+	return 0;
+}
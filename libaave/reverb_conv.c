@@ -0,0 +1,423 @@
+/*   This file is part of LibAAVE.
+ * 
+ *   LibAAVE is free software: you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation, either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   LibAAVE is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with LibAAVE.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *   Copyright 2014 André Oliveira, Nuno Silva, Guilherme Campos,
+ *   Paulo Dias, José Vieira/IEETA - Universidade de Aveiro
+ *
+ *
+ *   libaave/reverb_conv.c: partitioned convolution reverberator
+ */
+
+/**
+ * @file reverb_conv.c
+ *
+ * The reverb_conv.c file implements a late reverberator that convolves
+ * the sum of the anechoic sound sources pointed by @p aave->sources with a
+ * binaural late impulse response, as an alternative to the FDN of
+ * reverb_jot.c (AAVE_REVERB_CONV). The impulse response is either
+ * synthesised from the room parameters of @p aave->reverb
+ * (aave_reverb_conv_init()) or loaded from an offline simulation
+ * (aave_reverb_conv_set_ir()).
+ *
+ * The convolution uses non-uniform partitions: the impulse response is
+ * split into segments convolved by frequency-domain delay lines of block
+ * sizes AAVE_REVERB_CONV_BLOCK, 2, 4 and 8 times AAVE_REVERB_CONV_BLOCK,
+ * with the DFTs of dft.h, so that the cost per sample grows only with
+ * the number of partitions of the largest size, and the long partitions
+ * cost a few large DFTs instead of many small ones.
+ *
+ * Each segment starts one block of its size after the input, so that its
+ * contribution to an output block is calculated from input blocks that
+ * are already complete: the convolution adds no latency, only a delay of
+ * AAVE_REVERB_CONV_BLOCK samples, which is taken from the pre-delay of
+ * the reverberation. Each block of each segment is convolved with the
+ * overlap-add method.
+ *
+ * The levels all complete a block every 8 * AAVE_REVERB_CONV_BLOCK
+ * samples, so the multiply-accumulate of the older input blocks with the
+ * partitions of the last level, by far the most work, is spread over the
+ * AAVE_REVERB_CONV_BLOCK sized sub-blocks before, as these input blocks
+ * are already in its frequency-domain delay line: only the newest input
+ * block and the DFTs are left for the end of each block, and the cost of
+ * the sub-blocks stays even.
+ *
+ * Reference:
+ * William G. Gardner, "Efficient Convolution without Input-Output Delay",
+ * J. Audio Eng. Soc (AES), Vol. 43, No 3, Mar 1995.
+ */
+
+#include <math.h> /* exp(), log(), sqrt() */
+#include <stdlib.h> /* calloc(), free() */
+#include <string.h> /* memset() */
+#include "aave.h"
+
+/** Create a dft() function to convert the input and filters to frequency. */
+#define DFT_TYPE float
+#include "dft.h"
+
+/** Create an idft() function to convert the output back to time. */
+#define IDFT_TYPE float
+#include "idft.h"
+
+/**
+ * Ratio of the reverberation time at high frequencies to that at low
+ * frequencies of the synthesised impulse responses (as the alpha of
+ * reverb_jot.c).
+ */
+#define AAVE_REVERB_CONV_ALPHA 0.15
+
+/**
+ * Return the next sample of white noise, uniform in [-1;1[, of the
+ * linear congruential generator with state @p seed.
+ */
+static float noise(unsigned *seed)
+{
+	*seed = *seed * 1103515245 + 12345;
+
+	return (int)(*seed >> 8 & 0xffff) / 32768. - 1;
+}
+
+/**
+ * Calculate the Complex Multiplication and ADDition
+ * @p y += @p a * @p b of size @p n (see cmadd() of audio.c).
+ */
+static void cmadd(float *y, const float *a, const float *b, unsigned n)
+{
+	float ar, ai, br, bi;
+	unsigned i;
+
+	y[0] += a[0] * b[0]; /* A[0] */
+	y[1] += a[1] * b[1]; /* A[N/2] */
+
+	for (i = 2; i < n; i += 2) {
+		ar = a[i];
+		ai = a[i+1];
+		br = b[i];
+		bi = b[i+1];
+		y[i] += ar * br - ai * bi;
+		y[i+1] += ar * bi + ai * br;
+	}
+}
+
+/**
+ * Free the partitions of the convolution reverberator @p conv.
+ */
+static void aave_reverb_conv_free(struct aave_reverb_conv *conv)
+{
+	unsigned l;
+
+	for (l = 0; l < AAVE_REVERB_CONV_LEVELS; l++) {
+		free(conv->level[l].x);
+		free(conv->level[l].h);
+		free(conv->level[l].y);
+	}
+	free(conv);
+}
+
+/**
+ * Free the convolution reverberators of the late reverberator @p rev
+ * retired by the audio thread (see aave_reverb_conv_apply()).
+ */
+static void aave_reverb_conv_release(struct aave_reverb *rev)
+{
+	struct aave_reverb_conv *conv, *next;
+
+	conv = __atomic_exchange_n(&rev->retired_conv, NULL, __ATOMIC_ACQUIRE);
+	for (; conv; conv = next) {
+		next = conv->next;
+		aave_reverb_conv_free(conv);
+	}
+}
+
+/**
+ * Swap in the convolution reverberator of the late reverberator @p rev
+ * loaded with aave_reverb_conv_set_ir(), if any, and retire the one it
+ * replaces, for aave_reverb_conv_set_ir() to free.
+ * This is called by aave_reverb_apply() on the audio thread.
+ */
+void aave_reverb_conv_apply(struct aave_reverb *rev)
+{
+	struct aave_reverb_conv *conv, *old;
+
+	conv = __atomic_exchange_n(&rev->next_conv, NULL, __ATOMIC_ACQUIRE);
+	if (!conv)
+		return;
+	old = rev->conv;
+	__atomic_store_n(&rev->conv, conv, __ATOMIC_RELAXED);
+	if (!old)
+		return;
+
+	/* Lock-free: the list is only ever taken whole. */
+	old->next = __atomic_load_n(&rev->retired_conv, __ATOMIC_RELAXED);
+	while (!__atomic_compare_exchange_n(&rev->retired_conv, &old->next,
+			old, 1, __ATOMIC_RELEASE, __ATOMIC_RELAXED))
+		;
+}
+
+/**
+ * Use the @p length samples of the binaural late impulse response pointed
+ * by @p left and @p right (the first sample after the pre-delay of the
+ * reverberation) for the convolution reverberator of the auralisation
+ * world @p aave, and select it as the engine of the late reverberation
+ * (AAVE_REVERB_CONV).
+ * The impulse response is converted here, and the audio thread swaps the
+ * convolution reverberator in before the next frames it reverberates (see
+ * aave_reverb_apply()), so this may be called while aave_get_audio() runs.
+ * Reverberation unit must already be initialized.
+ * Returns 0 on success, or -1 if out of memory.
+ */
+int aave_reverb_conv_set_ir(struct aave *aave, const float *left,
+				const float *right, unsigned length)
+{
+	struct aave_reverb_conv *conv;
+	struct aave_reverb_conv_level *level;
+	const float *ir[2];
+	float x[AAVE_REVERB_CONV_BLOCK << AAVE_REVERB_CONV_LEVELS];
+	unsigned c, i, k, l, p, size, start;
+
+	conv = calloc(1, sizeof *conv);
+	if (!conv)
+		return -1;
+
+	ir[0] = left;
+	ir[1] = right;
+
+	/*
+	 * Segments of the impulse response: [0, B), [B, 3B), [3B, 7B),
+	 * and [7B, length) in partitions of 8B, for blocks of size B, 2B,
+	 * 4B and 8B, delayed by B, 2B, 4B and 8B from the input delayed by B.
+	 */
+	start = 0;
+	for (l = 0; l < AAVE_REVERB_CONV_LEVELS; l++) {
+		level = &conv->level[l];
+		size = AAVE_REVERB_CONV_BLOCK << l;
+		level->size = size;
+		level->partitions = 1;
+		if (l == AAVE_REVERB_CONV_LEVELS - 1)
+			level->partitions = length > start
+					? (length - start + size - 1) / size : 1;
+
+		level->x = calloc(level->partitions * size * 2,
+						sizeof *level->x);
+		level->h = calloc(level->partitions * size * 4,
+						sizeof *level->h);
+		level->y = calloc(size * 4, sizeof *level->y);
+		if (!level->x || !level->h || !level->y) {
+			aave_reverb_conv_free(conv);
+			return -1;
+		}
+
+		/* Convert each partition to frequency, zero padded. */
+		for (p = 0; p < level->partitions; p++) {
+			for (c = 0; c < 2; c++) {
+				for (i = 0; i < size; i++) {
+					k = start + p * size + i;
+					x[i] = k < length ? ir[c][k] : 0;
+				}
+				dft(level->h + (p * 2 + c) * size * 2, x,
+								size * 2);
+			}
+		}
+		start += size * level->partitions;
+	}
+
+	aave_reverb_conv_release(aave->reverb);
+
+	/* One not swapped in yet is replaced, and never used. */
+	conv = __atomic_exchange_n(&aave->reverb->next_conv, conv,
+							__ATOMIC_ACQ_REL);
+	if (conv)
+		aave_reverb_conv_free(conv);
+	__atomic_store_n(&aave->reverb->next_engine, AAVE_REVERB_CONV + 1,
+							__ATOMIC_RELEASE);
+	return 0;
+}
+
+/**
+ * Synthesise a binaural late impulse response for the room parameters of
+ * the reverberation unit of the auralisation world @p aave, and select
+ * the convolution reverberator with it (see aave_reverb_conv_set_ir()).
+ *
+ * The impulse response is uncorrelated white noise in each ear, split in
+ * a low and a high band by a one-pole filter, decaying at the reverberation
+ * time @p aave->reverb->rt60 and AAVE_REVERB_CONV_ALPHA times it,
+ * respectively, normalised to unit energy, and as long as the
+ * reverberation time, up to AAVE_REVERB_CONV_MAX_LENGTH samples.
+ * Reverberation unit must already be initialized.
+ * Returns 0 on success, or -1 if out of memory.
+ */
+int aave_reverb_conv_init(struct aave *aave)
+{
+	unsigned c, i, length, seed = 1;
+	float *ir[2], low, high, d0, d1, g0, g1, e;
+	int r;
+
+	length = aave->reverb->rt60 * (AAVE_FS / 1000.);
+	if (length > AAVE_REVERB_CONV_MAX_LENGTH)
+		length = AAVE_REVERB_CONV_MAX_LENGTH;
+	if (length < AAVE_REVERB_CONV_BLOCK)
+		length = AAVE_REVERB_CONV_BLOCK;
+
+	ir[0] = malloc(length * sizeof *ir[0]);
+	ir[1] = malloc(length * sizeof *ir[1]);
+	if (!ir[0] || !ir[1]) {
+		free(ir[0]);
+		free(ir[1]);
+		return -1;
+	}
+
+	/* Decay per sample of 60dB in the reverberation time, by band. */
+	d0 = exp(-3 * log(10) / length);
+	d1 = exp(-3 * log(10) / (length * AAVE_REVERB_CONV_ALPHA));
+
+	for (c = 0; c < 2; c++) {
+		low = 0;
+		g0 = g1 = 1;
+		e = 0;
+		for (i = 0; i < length; i++) {
+			high = noise(&seed);
+			low += 0.2 * (high - low);
+			high -= low;
+			ir[c][i] = low * g0 + high * g1;
+			g0 *= d0;
+			g1 *= d1;
+			e += ir[c][i] * ir[c][i];
+		}
+		for (i = 0; i < length; i++)
+			ir[c][i] /= sqrt(e);
+	}
+
+	r = aave_reverb_conv_set_ir(aave, ir[0], ir[1], length);
+
+	free(ir[0]);
+	free(ir[1]);
+	return r;
+}
+
+/**
+ * Accumulate the partitions @p first to @p last - 1 (at least 1) of
+ * @p level in its output spectra @p level->y, with the input blocks
+ * already in its frequency-domain delay line, for the next block.
+ */
+static void aave_reverb_conv_accumulate(struct aave_reverb_conv_level *level,
+					unsigned first, unsigned last)
+{
+	unsigned ch, j, p, n = level->size * 2;
+
+	for (p = first; p < last; p++) {
+		/* Input block p - 1 older than the newest one. */
+		j = level->index >= p - 1 ? level->index - (p - 1)
+				: level->index + level->partitions - (p - 1);
+		for (ch = 0; ch < 2; ch++)
+			cmadd(level->y + ch * n, level->x + j * n,
+					level->h + (p * 2 + ch) * n, n);
+	}
+}
+
+/**
+ * Convolve the input block of @p level of the convolution reverberator
+ * @p conv that ends at sample @p c, and add the result to the output ring
+ * from sample @p c on. The older partitions must already be accumulated
+ * in @p level->y (see aave_reverb_conv()).
+ */
+static void aave_reverb_conv_level(struct aave_reverb_conv *conv,
+				struct aave_reverb_conv_level *level, unsigned c)
+{
+	float x[AAVE_REVERB_CONV_BLOCK << AAVE_REVERB_CONV_LEVELS];
+	float y[AAVE_REVERB_CONV_BLOCK << AAVE_REVERB_CONV_LEVELS];
+	float *Y;
+	unsigned ch, i, n, size = level->size;
+	const unsigned mask = AAVE_REVERB_CONV_RING - 1;
+
+	n = size * 2;
+
+	/* Frequency-domain delay line: the newest input block. */
+	level->index = level->index + 1 < level->partitions
+						? level->index + 1 : 0;
+	for (i = 0; i < size; i++)
+		x[i] = conv->input[(c - size + i) & mask];
+	dft(level->x + level->index * n, x, n);
+
+	for (ch = 0; ch < 2; ch++) {
+		Y = level->y + ch * n;
+		cmadd(Y, level->x + level->index * n, level->h + ch * n, n);
+		idft(y, Y, n);
+		memset(Y, 0, n * sizeof Y[0]);
+
+		/* Overlap-add. */
+		for (i = 0; i < n; i++)
+			conv->output[ch][(c + i) & mask] += y[i];
+	}
+}
+
+/**
+ * Run the convolution reverberator on the @p n samples pointed by @p x,
+ * the pre-delayed sum of the anechoic sound sources (see aave_reverb()),
+ * and store the @p n binaural frames of the reverberation tail, attenuated
+ * by @p rev->mix and @p rev->level, in @p y.
+ * The input is read AAVE_REVERB_CONV_BLOCK samples less pre-delayed, as
+ * the convolution adds this delay.
+ */
+void aave_reverb_conv(struct aave_reverb *rev, const float *x, float *y,
+								unsigned n)
+{
+	struct aave_reverb_conv *conv = rev->conv;
+	struct aave_reverb_conv_level *level;
+	const unsigned mask = AAVE_REVERB_CONV_RING - 1;
+	unsigned c, i, k, l, m, s, t;
+	float g;
+
+	g = rev->mix * rev->level;
+
+	for (i = 0; i < n; i += k) {
+		c = conv->count;
+		k = AAVE_REVERB_CONV_BLOCK - (c & (AAVE_REVERB_CONV_BLOCK - 1));
+		if (k > n - i)
+			k = n - i;
+
+		for (t = 0; t < k; t++) {
+			conv->input[(c + t) & mask] = x[i + t];
+			y[(i + t) * 2 + 0] = conv->output[0][(c + t) & mask] * g;
+			y[(i + t) * 2 + 1] = conv->output[1][(c + t) & mask] * g;
+			conv->output[0][(c + t) & mask] = 0;
+			conv->output[1][(c + t) & mask] = 0;
+		}
+
+		/*
+		 * Convolve the blocks that are complete; of the others,
+		 * accumulate the share of their older partitions of the
+		 * sub-blocks s = 1, ..., m - 1 of the m of their size, or all
+		 * of them at the end if their size is a single sub-block.
+		 */
+		c += k;
+		conv->count = c;
+		if (c & (AAVE_REVERB_CONV_BLOCK - 1))
+			continue;
+		for (l = 0; l < AAVE_REVERB_CONV_LEVELS; l++) {
+			level = &conv->level[l];
+			m = level->size / AAVE_REVERB_CONV_BLOCK;
+			s = (c & (level->size - 1)) / AAVE_REVERB_CONV_BLOCK;
+			if (m == 1)
+				aave_reverb_conv_accumulate(level, 1,
+							level->partitions);
+			else if (s)
+				aave_reverb_conv_accumulate(level,
+				    1 + (level->partitions - 1) * (s - 1) / (m - 1),
+				    1 + (level->partitions - 1) * s / (m - 1));
+			if (!s)
+				aave_reverb_conv_level(conv, level, c);
+		}
+	}
+}
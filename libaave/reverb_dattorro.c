@@ -23,13 +23,18 @@
 /**
  * @file reverb_dattorro.c
  *
- * The reverb_dattorro.c file implements a Dattorro reverberator
+ * The reverb_dattorro.c file implements a Dattorro plate reverberator
  * to add an artificial reverberation tail to the output of the auralisation
  * generated by the audio.c part of the auralisation process, to simulate
  * the late reflections that the geometry.c part of the auralisation process
- * could not determine in time.
+ * could not determine in time. It is cheaper than the FDN of reverb_jot.c,
+ * but its decay does not follow the room parameters.
  *
- * @todo Make the code reentrant (move the static structures to aave).
+ * The reverberator is processed in blocks of up to AAVE_DATTORRO_BLOCK
+ * samples, one stage at a time, with the delay lines and all-pass filters
+ * in rings of AAVE_DATTORRO_RING samples with a write index common to all
+ * rings (no modulo). Each block is shorter than the delay from a tank to
+ * the other, so the inputs of both tanks are known before the block.
  *
  * Reference:
  * Jon Dattorro, "Effect Design, Part 1: Reverberator and Other Filters",
@@ -38,8 +43,11 @@
 
 #include "aave.h"
 
-/** Pre-delay, in number of samples (150ms). */
-#define PREDELAY (0.15 * AAVE_FS)
+/**
+ * Maximum number of samples processed at a time: must not exceed the
+ * shortest second delay line of the tanks plus 1.
+ */
+#define AAVE_DATTORRO_BLOCK 256
 
 /** Bandwidth of the early low-pass filter. */
 #define BANDWIDTH 0.7
@@ -61,207 +69,142 @@
 /** Gain of the wet path of the reverberator. */
 #define WET 0.3
 
-/**
- * Data of a delay block.
- */
-struct delay {
-
-	/** Index to the latest value inserted in the buffer. */
-	unsigned index;
-
-	/**
-	 * Buffer to store the inserted values.
-	 * @todo Set maximum delay from the delays of all delay blocks.
-	 */
-	float buffer[16384];
+/** Delays of the early all-pass filters, and their gains. */
+static const struct {
+	unsigned delay;
+	float g;
+} input_allpass[4] = {
+	{ 142, INPUT_DIFFUSION_1 },
+	{ 107, INPUT_DIFFUSION_1 },
+	{ 379, INPUT_DIFFUSION_2 },
+	{ 277, INPUT_DIFFUSION_2 }
 };
 
-/**
- * Data of a low-pass filter.
- */
-struct lowpass {
-
-	/** Previous output of the filter (y[n-1]). */
-	float y;
+/** Delays of the all-pass filters and delay lines of the tanks. */
+static const struct {
+	unsigned ap0;
+	unsigned delay0;
+	unsigned ap1;
+	unsigned delay1;
+} tank_delays[2] = {
+	{ 672, 4453, 1800, 3720 },
+	{ 908, 4217, 2656, 3163 }
 };
 
 /**
- * Data of an all-pass filter.
- */
-struct allpass {
-
-	/** Value captured inside the feedback network. */
-	float tap;
-
-	/** Index to the latest value inserted in the buffer. */
-	unsigned index;
-
-	/**
-	 * Buffer to store the inserted values.
-	 * @todo Set maximum delay from the delays of all all-pass blocks.
-	 */
-	float buffer[2656];
-};
-
-/**
- * Data of a decay block.
- */
-struct decay_block {
-
-	/** The previous output value. */
-	float out;
-
-	/** The dampping low-pass filter. */
-	struct lowpass lp;
-
-	/** The decay all-pass filters. */
-	struct allpass ap[2];
-
-	/** The delay lines. */
-	struct delay delay[2];
-};
-
-/**
- * Execute a delay block: y[n] = x[n - k].
- * @p d is the delay block data,
- * @p x is the input value, and
- * @p k is the number of samples of delay.
- * Returns the output value y[n].
- */
-static float delay(struct delay *d, float x, unsigned k)
-{
-	float y;
-	unsigned i;
-
-	i = (d->index + 1) % k;
-	d->index = i;
-
-	y = d->buffer[i];
-	d->buffer[i] = x;
-
-	return y;
-}
-
-/**
- * Execute a low-pass filter: y[n] = b * x[n] + (1 - b) * y[n-1].
- * @p lp is the low-pass filter data,
- * @p x is the input value,
- * @p b is the bandwidth/damping coefficient.
- * Returns the output value y[n].
+ * Run the all-pass filter H(z) = (g + z^-k) / (1 + g z^-k) of ring
+ * @p ring, with the gain @p g and the delay @p k, on the @p n samples
+ * pointed by @p x, in place, @p w being the ring index of the first one.
  */
-static float lowpass(struct lowpass *lp, float x, float b)
+static void allpass(float *ring, float *x, unsigned n, unsigned w,
+						float g, unsigned k)
 {
-	lp->y = b * x + (1 - b) * lp->y;
+	const unsigned mask = AAVE_DATTORRO_RING - 1;
+	float x1, x2;
+	unsigned t;
 
-	return lp->y;
+	for (t = 0; t < n; t++) {
+		x2 = ring[(w + t - k) & mask];
+		x1 = x[t] - g * x2;
+		ring[(w + t) & mask] = x1;
+		x[t] = x1 * g + x2;
+	}
 }
 
 /**
- * Execute an all-pass filter: H(z) = (g + z^-k) / (1 + g z^-k).
- * @p ap is the all-pass filter data,
- * @p x is the input value,
- * @p g is the gain coefficient, and
- * @p delay is the number of samples of delay.
- * Returns the output value of the all-pass filter.
+ * Run the tank @p tank of index @p i (0 or 1) on the @p n samples
+ * pointed by @p x, plus the output of the other tank @p other,
+ * @p w being the ring index of the first sample.
  */
-static float allpass(struct allpass *ap, float x, float g, unsigned delay)
+static void tank_block(struct aave_dattorro_tank *tank,
+		const struct aave_dattorro_tank *other, unsigned i,
+		const float *x, unsigned n, unsigned w)
 {
-	float x1, x2;
-	unsigned index;
-
-	index = (ap->index + 1) % delay;
-	ap->index = index;
+	const unsigned mask = AAVE_DATTORRO_RING - 1;
+	float u[AAVE_DATTORRO_BLOCK], lp, out, damping = DAMPING;
+	unsigned t, k;
+
+	/* Input, with the output of the other tank one sample before. */
+	k = tank_delays[!i].delay1 + 1;
+	for (t = 0; t < n; t++) {
+		out = other->delay1[(w + t - k) & mask] * DECAY;
+		u[t] = x[t] + out;
+	}
 
-	x2 = ap->buffer[index];
-	x1 = x - g * x2;
-	ap->buffer[index] = x1;
-	ap->tap = x1; /** @todo Check if the tap is really x1 or x2. */
-	return x1 * g + x2;
-}
+	allpass(tank->ap0, u, n, w, DECAY_DIFFUSION_1, tank_delays[i].ap0);
+
+	/* First delay line, damping and decay. */
+	k = tank_delays[i].delay0;
+	lp = tank->lp;
+	for (t = 0; t < n; t++) {
+		tank->delay0[(w + t) & mask] = u[t];
+		lp = damping * tank->delay0[(w + t - k) & mask]
+						+ (1 - damping) * lp;
+		u[t] = lp * DECAY;
+		tank->damped[(w + t) & mask] = u[t];
+	}
+	tank->lp = lp;
 
-/**
- * Execute a decay block.
- * @p b is the decay block data,
- * @p x is the input value,
- * @p i is the index of the decay block parameters to use (0 or 1), and
- * @p out1, @p out2, @p out3 are the output taps.
- */
-static void decay_block(struct decay_block *b, float x, unsigned i,
-			float *out1, float *out2, float *out3)
-{
-	static const struct {
-		float ap0_delay;
-		unsigned delay0;
-		float ap1_delay;
-		unsigned delay1;
-	} param[] = {
-		{ 672, 4453, 1800, 3720 },
-		{ 908, 4217, 2656, 3163 }
-	};
+	allpass(tank->ap1, u, n, w, DECAY_DIFFUSION_2, tank_delays[i].ap1);
 
-	x = allpass(&b->ap[0], x, DECAY_DIFFUSION_1, param[i].ap0_delay);
-	*out1 = x;
-	x = delay(&b->delay[0], x, param[i].delay0);
-	x = lowpass(&b->lp, x, DAMPING);
-	x *= DECAY;
-	*out2 = x; /**/
-	x = allpass(&b->ap[1], x, DECAY_DIFFUSION_2, param[i].ap1_delay);
-	*out3 = b->ap[1].tap;
-	x = delay(&b->delay[1], x, param[i].delay1);
-	x *= DECAY;
-	b->out = x;
+	for (t = 0; t < n; t++)
+		tank->delay1[(w + t) & mask] = u[t];
 }
 
 /**
- * Run a Dattorro reverberator to add an artificial reverberation tail
- * to the @p n binaural frames (2 * @p n samples) pointed by @p audio.
+ * Run a Dattorro reverberator on the @p n samples pointed by @p x, the
+ * pre-delayed sum of the anechoic sound sources (see aave_reverb()), and
+ * store the @p n binaural frames of the reverberation tail, attenuated by
+ * @p rev->mix and @p rev->level, in @p y.
  */
-void aave_reverb_dattorro(struct aave *aave, short *audio, unsigned n)
+void aave_reverb_dattorro(struct aave_reverb *rev, const float *x, float *y,
+								unsigned n)
 {
-	static struct delay predelay;
-	static struct lowpass lp1;
-	static struct allpass ap[4];
-	static struct delay d[14];
-	static struct decay_block b[2];
-	float x, xl, xr, out[6];
-	unsigned i;
-
-	for (i = 0; i < n; i++) {
-		x = (audio[i*2] + audio[i*2+1]) * 0.5;
-
-		x = delay(&predelay, x, PREDELAY);
-
-		x = lowpass(&lp1, x, BANDWIDTH);
-
-		x = allpass(&ap[0], x, INPUT_DIFFUSION_1, 142);
-		x = allpass(&ap[1], x, INPUT_DIFFUSION_1, 107);
-		x = allpass(&ap[2], x, INPUT_DIFFUSION_2, 379);
-		x = allpass(&ap[3], x, INPUT_DIFFUSION_2, 277);
-
-		xl = b[0].out;
-		xr = b[1].out;
-
-		decay_block(&b[0], x + xr, 0, &out[0], &out[1], &out[2]);
-		decay_block(&b[1], x + xl, 1, &out[3], &out[4], &out[5]);
-
-		/* left */
-		audio[i * 2 + 0] = audio[i * 2 + 0] + WET * (
-			- delay(&d[2], out[0], 1990)
-			- delay(&d[4], out[1], 187)
-			- delay(&d[6], out[2], 1066)
-			+ delay(&d[8], out[3], 2974)
-			+ delay(&d[9], out[3], 266)
-			- delay(&d[11], out[4], 1913)
-			+ delay(&d[13], out[5], 1996));
-
-		/* right */
-		audio[i * 2 + 1] = audio[i * 2 + 1] + WET * (
-			+ delay(&d[0], out[0], 353)
-			+ delay(&d[1], out[0], 3627)
-			- delay(&d[3], out[1], 1228)
-			+ delay(&d[5], out[2], 2673)
-			- delay(&d[7], out[3], 2111)
-			- delay(&d[10], out[4], 335)
-			- delay(&d[12], out[5], 121));
+	struct aave_dattorro *r = &rev->dattorro;
+	const struct aave_dattorro_tank *l = &r->tank[0], *R = &r->tank[1];
+	const unsigned mask = AAVE_DATTORRO_RING - 1;
+	float v[AAVE_DATTORRO_BLOCK], g, lp, bandwidth = BANDWIDTH;
+	unsigned i, j, b, t, w;
+
+	g = WET * rev->mix * rev->level;
+
+	for (i = 0; i < n; i += b) {
+		b = n - i < AAVE_DATTORRO_BLOCK ? n - i : AAVE_DATTORRO_BLOCK;
+		w = r->index;
+
+		/* Early low-pass and all-pass filters. */
+		lp = r->lp;
+		for (t = 0; t < b; t++) {
+			lp = bandwidth * x[i + t] + (1 - bandwidth) * lp;
+			v[t] = lp;
+		}
+		r->lp = lp;
+		for (j = 0; j < 4; j++)
+			allpass(r->ap[j], v, b, w, input_allpass[j].g,
+						input_allpass[j].delay);
+
+		tank_block(&r->tank[0], &r->tank[1], 0, v, b, w);
+		tank_block(&r->tank[1], &r->tank[0], 1, v, b, w);
+
+		/* Output taps. */
+		for (t = 0; t < b; t++, w++) {
+			y[(i + t) * 2 + 0] = g * (
+				- l->delay0[(w - 1990) & mask]
+				- l->damped[(w - 187) & mask]
+				- l->ap1[(w - 1066) & mask]
+				+ R->delay0[(w - 2974) & mask]
+				+ R->delay0[(w - 266) & mask]
+				- R->damped[(w - 1913) & mask]
+				+ R->ap1[(w - 1996) & mask]);
+			y[(i + t) * 2 + 1] = g * (
+				+ l->delay0[(w - 353) & mask]
+				+ l->delay0[(w - 3627) & mask]
+				- l->damped[(w - 1228) & mask]
+				+ l->ap1[(w - 2673) & mask]
+				- R->delay0[(w - 2111) & mask]
+				- R->damped[(w - 335) & mask]
+				- R->ap1[(w - 121) & mask]);
+		}
+		r->index = w;
 	}
 }
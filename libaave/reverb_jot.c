@@ -56,14 +56,12 @@
  * USING TIME-VARIANT FEEDBACK DELAY NETWORKS", Master Thesis, Dec 2000.
  */
 
+#include <string.h> /* memset() */
 #include "aave.h"
 #include "math.h"
 #include "stdio.h"
 #include "stdlib.h"
 
-/** Define a maximum delay time of 200 ms */
-#define MAX_DELAY_TIME 8820
-
 /** N = 64 delay sizes for each fdn delay line. Prime numbers within the range 0 - 1800. */
 	static const short feedback_delays[FDN_ORDER] = {29,53,79,101,127,149,173,197,223,251,277,307,331,353,379,401,431,457,479,503,541,563,587,613,641,673,701,727,751,773,797,821,853,877,907,929,953,977,1009,1031,1061,1087,1109,1151,1181,1213,1237,1259,1283,1307,1361,1399,1423,1447,1471,1493,1523,1549,1571,1597,1619,1657,1693,1721};
 
@@ -78,85 +76,38 @@
 	/* static const short feedback_delays[FDN_ORDER] = {251,311,347,409,499,563,601,691,733,773,839,919,977,1031,1129,1201};*/
 
 /**
- * Data of a delay filter.
+ * Maximum number of samples processed at a time by the FDN: each block is
+ * also limited to the shortest delay line, so that the outputs of all
+ * delay lines for the block were written before the block.
  */
-struct delay_filter {
-
-    /** Index to the latest value inserted in the buffer. */
-    unsigned index;
-
-    /**
-     * Buffer to store the inserted values.
-     */
-    float buffer[MAX_DELAY_TIME];
-};
-
-/**
- * Data of a low-pass filter for frequency-dependent reverberation time.
- */
-struct absorption_filter {
-
-    /** Previous output of the filter (y[n-1]). */
-    float y;
-};
+#define AAVE_REVERB_BLOCK 32
 
 /**
- * Data of a tone correction (high pass) filter.
+ * Select the delay lines of the FDN of order @p rev->order, evenly spread
+ * over @p feedback_delays, and calculate their absorption filters and
+ * decorrelation coefficients for the reverberation time @p rev->rt60.
  */
-struct tone_correction_filter {
-
-    /** Previous output of the filter (y[n-1]). */
-    float y;
-};
-
-/**
- * Data of a dc block filter for a rough reverb highpass.
- * @todo Improve bandwidth definition.
- */
-struct dc_block_filter {
-
-    /** Previous output of the filter (y[n-1]). */
-    float y;
-    /** Previous input of the filter (x[n-1]). */
-    float x;
-    /** bandwidth. */
-    float b;
-} dcbf[] = {{0,0,0.01},{0,0,0.01}};
-
-/**
- * Execute a delay block: y[n] = x[n - k].
- * @p d is the delay block data,
- * @p x is the input value, and
- * @p k is the number of samples of delay.
- * Returns the output value y[n].
- */
-static float process_delay_filter(struct delay_filter *d, float x, unsigned k)
+static void aave_reverb_set_lines(struct aave_reverb *rev)
 {
-    float y;
     unsigned i;
 
-    i = (d->index + 1) % k;
-    d->index = i;
+    for (i = 0; i < rev->order; i++) {
 
-    y = d->buffer[i];
-    d->buffer[i] = x;
+        rev->delays[i] = feedback_delays[i * FDN_ORDER / rev->order];
 
-    return y;
-}
+        if (i%2) rev->decorrelation_coefs[i][0]=-1;
+        else rev->decorrelation_coefs[i][0]=1;
 
-/**
- * Execute a low-pass filter with gain atenuation: y[n] = g * (1-b) * x[n] + b * y[n-1].
- * @p lp is the low-pass filter data,
- * @p x is the input value,
- * @p b is the bandwidth/damping coefficient.
- * @p b is the gain atenuation.
- * Returns the output value y[n].
- */
-static float process_absorption_filter(struct absorption_filter *af, float x, float g, float b)
-{
-    af->y = g * (1-b) * x + b * af->y;
+        rev->fdn_output_taps[i]=0;
+        rev->absorption[i]=0;
+        rev->absorption_gain[i] = pow(10,(-3*rev->delays[i]*(1000./ AAVE_FS))/rev->rt60);
+        rev->absorption_bandwidth[i] = 1 - ( 2 / (1+pow(rev->absorption_gain[i],1 - 1./rev->alpha)));
+    }
 
-    return af->y;
+    for (i=0;i<rev->order;i+=2) {
+        if( i/2 % 2) rev->decorrelation_coefs[i][1] = rev->decorrelation_coefs[i+1][1]=-1;
+        else rev->decorrelation_coefs[i][1] = rev->decorrelation_coefs[i+1][1] = 1;
+    }
 }
 
 /**
@@ -166,7 +117,7 @@ static float process_absorption_filter(struct absorption_filter *af, float x, fl
  * @p b is the bandwidth/damping coefficient.
  * Returns the output value y[n].
  */
-static float process_tone_correction_filter(struct tone_correction_filter *tcf, float x, float b)
+static float process_tone_correction_filter(struct aave_tone_correction_filter *tcf, float x, float b)
 {
 
     float y = (x - b * tcf->y) / (1-b);
@@ -181,7 +132,7 @@ static float process_tone_correction_filter(struct tone_correction_filter *tcf,
  * @p x is the input value,
  * Returns the output value dcbf->y.
  */
-static float process_dc_block_filter(struct dc_block_filter *dcbf, float x)
+static float process_dc_block_filter(struct aave_dc_block_filter *dcbf, float x)
 {
 
     dcbf->y = (1-0.5 * dcbf->b) * (x - dcbf->x) + ((1 - dcbf->b) * dcbf->y);
@@ -198,7 +149,7 @@ void aave_reverb_print_parameters(struct aave* aave, struct aave_reverb *rev) {
 	printf(" ROOM ABS COEF = %f\n",aave->room_material_absorption);
 	printf(" REVERB MIX = %.2f\n",rev->mix);
 	printf(" CRITICAL DISTANCE = %.2f (m)\n",rev->rc);
-	printf(" FDN ORDER = %d\n",FDN_ORDER);
+	printf(" FDN ORDER = %d\n",rev->order);
 	printf(" RT60 = %.2d (ms)\n",aave->reverb->rt60);
 	printf(" ALPHA = %.2f\n",rev->alpha);	
 	printf(" PREDELAY = %.2f (ms)\n",rev->Tmixing);
@@ -211,7 +162,6 @@ void aave_reverb_print_parameters(struct aave* aave, struct aave_reverb *rev) {
  */
 void aave_reverb_init(struct aave *aave) {
 
-    int i;
     struct aave_surface *surface;
 
     /* Default values for room area, volume and rt60. */
@@ -222,7 +172,9 @@ void aave_reverb_init(struct aave *aave) {
     if (aave->reverb != NULL)
 		return;
 
-    aave->reverb = (struct aave_reverb*) malloc(sizeof(struct aave_reverb));
+    aave->reverb = (struct aave_reverb*) calloc(1, sizeof(struct aave_reverb));
+    if (aave->reverb == NULL)
+		return;
     aave->reverb_active = 1;
 
     aave->reverb->level = 1;
@@ -232,6 +184,8 @@ void aave_reverb_init(struct aave *aave) {
     aave->reverb->Tmixing = sqrt((float) volume);
 	aave->reverb->pre_delay += aave->reverb->Tmixing * 0.001 * AAVE_FS;
 
+    aave->reverb->dcbf[0].b = aave->reverb->dcbf[1].b = 0.01;
+
     aave->reverb->alpha = 0.15;
     aave->reverb->beta = (1-sqrt(aave->reverb->alpha))/(1+sqrt(aave->reverb->alpha));
 
@@ -241,20 +195,11 @@ void aave_reverb_init(struct aave *aave) {
     aave->reverb->rc = pow( (area * aave->room_material_absorption) / (16 * M_PI), 0.5);
     aave->reverb->mix = 1 / aave->reverb->rc;
 
-    for (i=0;i<FDN_ORDER;i++) {
-
-        if (i%2) aave->reverb->decorrelation_coefs[i][0]=-1;
-        else aave->reverb->decorrelation_coefs[i][0]=1;
-
-        aave->reverb->fdn_output_taps[i]=0;
-        aave->reverb->absorption_gain[i] = pow(10,(-3*feedback_delays[i]*(1000./ AAVE_FS))/RT60);
-        aave->reverb->absorption_bandwidth[i] = 1 - ( 2 / (1+pow(aave->reverb->absorption_gain[i],1 - 1./aave->reverb->alpha)));
-    }
+    aave->reverb->rt60 = RT60;
+    aave->reverb->order = FDN_ORDER;
+    aave_reverb_set_lines(aave->reverb);
 
-    for (i=0;i<FDN_ORDER;i+=2) {
-        if( i/2 % 2) aave->reverb->decorrelation_coefs[i][1] = aave->reverb->decorrelation_coefs[i+1][1]=-1;
-        else aave->reverb->decorrelation_coefs[i][1] = aave->reverb->decorrelation_coefs[i+1][1] = 1;
-    }
+    aave->reverb->engine = aave_reverb_jot;
 }
 
 /**
@@ -292,82 +237,144 @@ void aave_reverb_set_area(struct aave *aave, unsigned short area)
  */
 void aave_reverb_set_rt60(struct aave *aave, unsigned short RT60)
 {
-    unsigned short i;
-
+    aave_reverb_sync(aave);
     aave->reverb->rt60 = RT60;
 
     aave->reverb->alpha = 0.15;
     aave->reverb->beta = (1-sqrt(aave->reverb->alpha))/(1+sqrt(aave->reverb->alpha));
 
-    for (i=0;i<FDN_ORDER;i++) {
+    aave_reverb_set_lines(aave->reverb);
+}
 
-        if (i%2) aave->reverb->decorrelation_coefs[i][0]=-1;
-        else aave->reverb->decorrelation_coefs[i][0]=1;
+/**
+ * Set the order of the FDN (the number of delay lines), from 4 to
+ * FDN_ORDER, a multiple of 4, to trade the density of the late reverberation for
+ * processing time. The order is only requested here: the audio thread
+ * applies it, and clears the delay lines, before the next frames it
+ * reverberates (see aave_reverb_apply_order()).
+ * Reverberation unit must already be initialized.
+ */
+void aave_reverb_set_order(struct aave *aave, unsigned order)
+{
+    if (order < 4)
+        order = 4;
+    if (order > FDN_ORDER)
+        order = FDN_ORDER;
 
-        aave->reverb->fdn_output_taps[i]=0;
-        aave->reverb->absorption_gain[i] = pow(10,(-3*feedback_delays[i]*(1000./ AAVE_FS))/RT60);
-        aave->reverb->absorption_bandwidth[i] = 1 - (2 / (1+pow(aave->reverb->absorption_gain[i],1 - 1./aave->reverb->alpha)));
-    }
+    __atomic_store_n(&aave->reverb->next_order, order & ~3, __ATOMIC_RELAXED);
+}
 
-    for (i=0;i<FDN_ORDER;i+=2) {
-        if( i/2 % 2) aave->reverb->decorrelation_coefs[i][1] = aave->reverb->decorrelation_coefs[i+1][1]=-1;
-        else aave->reverb->decorrelation_coefs[i][1] = aave->reverb->decorrelation_coefs[i+1][1] = 1;
-    }
+/**
+ * Apply the order of the FDN of the late reverberator @p rev requested
+ * with aave_reverb_set_order(), if any, and clear the delay lines in use.
+ * This is called by aave_reverb_apply() on the audio thread, when the
+ * worker thread of the reverberator, if any, is idle.
+ */
+void aave_reverb_apply_order(struct aave_reverb *rev)
+{
+    unsigned order;
+
+    order = __atomic_exchange_n(&rev->next_order, 0, __ATOMIC_RELAXED);
+    if (!order || order == rev->order)
+        return;
+
+    /* Only the lines in use are read before they are written. */
+    rev->order = order;
+    aave_reverb_set_lines(rev);
+    memset(rev->lines, 0, order * sizeof rev->lines[0]);
 }
 
 /**
- * Run a Jot FDN reverberator to add an artificial reverberation tail
- * to the @p n single channel frames (@p n samples) of each anechoic
- * sound source pointed by @p aave->sources. Store output in @p audio.
+ * Run a Jot FDN reverberator on the @p n samples pointed by @p x, the
+ * pre-delayed sum of the anechoic sound sources (see aave_reverb()), and
+ * store the @p n binaural frames of the reverberation tail, attenuated by
+ * @p rev->mix and @p rev->level, in @p y.
+ *
+ * The FDN is processed in blocks of up to AAVE_REVERB_BLOCK samples:
+ * the delay lines are read and written in contiguous spans of a ring of
+ * AAVE_REVERB_LINE_SIZE samples with a write index common to all lines
+ * (no modulo), and the per-line operations run 4 lines at a time, in
+ * SIMD lanes.
+ * The Householder feedback matrix is applied in O(N) per sample, as the
+ * sum of the line outputs minus the permuted outputs.
  */
-void aave_reverb_jot(struct aave *aave, short *audio, unsigned n)
+void aave_reverb_jot(struct aave_reverb *rev, const float *x, float *y,
+								unsigned n)
 {
 
-    struct aave_reverb *rev = aave->reverb;
-    struct aave_source *source = aave->sources;
-    static struct delay_filter predelay;
-    static struct tone_correction_filter tcf[2];
-    static struct absorption_filter af[FDN_ORDER];
-    static struct delay_filter df[FDN_ORDER];
-    float x, y[2], buffer[FDN_ORDER];
-    unsigned i,j;
-    float acum;
-      
-    /* printf("mix = %.2f, aave_mix_factor = %.2f, rc = %f\n",rev->mix * rev->level, rev->level, rev->rc); */    
-    /* printf("source = %p,buffer = %p, n = %d\n",(void*) source, (void*) audio,n); */   
-    
-    for (i = 0; i < n; i++) {
-
-        acum = y[0] = y[1] = x = 0;
-	source = aave->sources;
-	
-	while (source) {
-        x += source->buffer[ (source->buffer_index - n + i) & (AAVE_SOURCE_BUFSIZE - 1)];
-	    source = source->next;
-	}
-        
-        x = process_delay_filter(&predelay, x,rev->pre_delay);
-
-        for (j=0;j<FDN_ORDER;j++) {
-            buffer[j] = x + rev->fdn_output_taps[j];
-            buffer[j] = process_delay_filter(&df[j],buffer[j],feedback_delays[j]);
-            buffer[j] = process_absorption_filter(&af[j],buffer[j],rev->absorption_gain[j],rev->absorption_bandwidth[j]);
-            acum += buffer[j] * (2./(float)FDN_ORDER);	
+    float z[2];
+    float o[AAVE_REVERB_BLOCK][FDN_ORDER], in[AAVE_REVERB_BLOCK][FDN_ORDER];
+    float *line, *taps = rev->fdn_output_taps;
+    unsigned i, j, k, l, t, b, w;
+    unsigned N = rev->order;
+    unsigned mask = AAVE_REVERB_LINE_SIZE - 1;
+    float a, acum, s[4], s0[4], s1[4];
+
+    for (i = 0; i < n; i += b) {
+
+        b = n - i;
+        if (b > AAVE_REVERB_BLOCK)
+            b = AAVE_REVERB_BLOCK;
+        if (b > rev->delays[0])
+            b = rev->delays[0];
+
+        /* Outputs of the delay lines, written before this block. */
+        w = rev->line_index;
+        for (j = 0; j < N; j++) {
+            line = rev->lines[j];
+            k = w - rev->delays[j];
+            for (t = 0; t < b; t++)
+                o[t][j] = line[(k + t) & mask];
         }
 
-        for (j=0;j<FDN_ORDER;j++) {       
-            rev->fdn_output_taps[j] = acum - buffer[(j+FDN_ORDER-1) % FDN_ORDER];
-            y[0] += rev->decorrelation_coefs[j][0] * buffer[j] * (1./(float)FDN_ORDER);
-            y[1] += rev->decorrelation_coefs[j][1] * buffer[j] * (1./(float)FDN_ORDER);       
+        for (t = 0; t < b; t++) {
+
+            /* Inputs of the delay lines, with the previous taps. */
+            for (j = 0; j < N; j++)
+                in[t][j] = x[i + t] + taps[j];
+
+            /*
+             * Absorption filters, and sums of the outputs for the feedback
+             * matrix and the stereo output, 4 lines at a time.
+             */
+            for (l = 0; l < 4; l++)
+                s[l] = s0[l] = s1[l] = 0;
+            for (j = 0; j < N; j += 4) {
+                for (l = 0; l < 4; l++) {
+                    a = rev->absorption_gain[j + l] * (1 - rev->absorption_bandwidth[j + l]) * o[t][j + l] + rev->absorption_bandwidth[j + l] * rev->absorption[j + l];
+                    rev->absorption[j + l] = a;
+                    o[t][j + l] = a;
+                    s[l] += a;
+                    s0[l] += rev->decorrelation_coefs[j + l][0] * a;
+                    s1[l] += rev->decorrelation_coefs[j + l][1] * a;
+                }
+            }
+
+            /* Householder feedback matrix, with a circular permutation. */
+            acum = (s[0] + s[1] + s[2] + s[3]) * (2.f / N);
+            taps[0] = acum - o[t][N - 1];
+            for (j = 1; j < N; j++)
+                taps[j] = acum - o[t][j - 1];
+
+            z[0] = (s0[0] + s0[1] + s0[2] + s0[3]) * (1.f / N);
+            z[1] = (s1[0] + s1[1] + s1[2] + s1[3]) * (1.f / N);
+
+            z[0] = process_tone_correction_filter(&rev->tcf[0],z[0],rev->beta);
+            z[1] = process_tone_correction_filter(&rev->tcf[1],z[1],rev->beta);
+
+            z[0] = process_dc_block_filter(&rev->dcbf[0],z[0]);
+            z[1] = process_dc_block_filter(&rev->dcbf[1],z[1]);
+
+            y[(i + t) * 2 + 0] = z[0] * rev->mix * rev->level;
+            y[(i + t) * 2 + 1] = z[1] * rev->mix * rev->level;
         }
-            
-            y[0] = process_tone_correction_filter(&tcf[0],y[0],rev->beta);
-            y[1] = process_tone_correction_filter(&tcf[1],y[1],rev->beta);
-
-            y[0] = process_dc_block_filter(&dcbf[0],y[0]);
-            y[1] = process_dc_block_filter(&dcbf[1],y[1]);
 
-            audio[i * 2 + 0] = (audio[i * 2 + 0] + (y[0] * rev->mix * rev->level)) * aave->gain;
-            audio[i * 2 + 1] = (audio[i * 2 + 1] + (y[1] * rev->mix * rev->level)) * aave->gain; 
+        /* Write the inputs of the delay lines. */
+        for (j = 0; j < N; j++) {
+            line = rev->lines[j];
+            for (t = 0; t < b; t++)
+                line[(w + t) & mask] = in[t][j];
+        }
+        rev->line_index = w + b;
     }
 }
@@ -0,0 +1,318 @@
+/*   This file is part of LibAAVE.
+ * 
+ *   LibAAVE is free software: you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation, either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   LibAAVE is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with LibAAVE.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *   Copyright 2014 André Oliveira, Nuno Silva, Guilherme Campos,
+ *   Paulo Dias, José Vieira/IEETA - Universidade de Aveiro
+ *
+ *
+ *   libaave/source.c: sound source sample input
+ */
+
+/**
+ * @file source.c
+ *
+ * The source.c file implements the sound sources whose anechoic samples
+ * are read directly from memory, instead of being put block by block in
+ * the ring buffer of the source with aave_put_audio().
+ *
+ * The samples are 16-bit mono at AAVE_FS, either in an array owned by
+ * the caller, set with aave_set_source_samples(), or in a PCM file
+ * (raw or RIFF WAVE) mapped in memory with aave_set_source_file(),
+ * optionally looped. The resampler reads the samples of each block
+ * from the array, in the one or two contiguous spans they take there
+ * (see aave_source_window()), so these sources have no ring buffer: it is
+ * released when their samples are set, and aave_alloc_source_buffer()
+ * allocates it again before samples are put in them with aave_put_audio().
+ *
+ * The samples of these sources advance with the frames generated by
+ * aave_get_audio(), as if the same number of frames had been put with
+ * aave_put_audio() just before.
+ *
+ * Setting the samples of a source stops its streaming (see stream.c) and
+ * releases the file it mapped before, if any. Like the other functions
+ * that change the samples of a source, these must not be called while
+ * aave_get_audio() runs.
+ */
+
+#include <limits.h> /* INT_MAX */
+#include <stdlib.h> /* free() */
+#include <string.h> /* memcmp(), memcpy(), memset() */
+#include "aave.h"
+
+#ifdef _WIN32
+#include <stdio.h> /* fopen() */
+#else
+#include <fcntl.h> /* open() */
+#include <sys/mman.h> /* mmap() */
+#include <sys/stat.h> /* fstat() */
+#include <unistd.h> /* close() */
+#endif
+
+/**
+ * Return the anechoic sample of index @p i of @p source (see
+ * aave_source::buffer_index), or 0 if there is no such sample.
+ */
+float aave_source_sample(const struct aave_source *source, unsigned i)
+{
+	if (source->samples) {
+		/* Samples before the start of the array. */
+		if (i > INT_MAX)
+			return 0;
+		if (i < source->nsamples)
+			return source->samples[i];
+		if (!source->loop)
+			return 0;
+		return source->samples[i % source->nsamples];
+	}
+
+	if (source->buffer)
+		return source->buffer[i & (AAVE_SOURCE_BUFSIZE - 1)];
+
+	return 0;
+}
+
+/**
+ * Store in @p x the @p n anechoic samples of @p source from index @p i
+ * on, as aave_source_sample() would return them, copied from the one or
+ * two contiguous spans they take in the samples or the ring buffer of
+ * the source (more only if a looped array is shorter than @p n).
+ */
+void aave_source_window(const struct aave_source *source, float *x,
+							unsigned i, unsigned n)
+{
+	const short *s = source->samples;
+	unsigned j, k, m;
+
+	for (; n; x += m, i += m, n -= m) {
+		m = n;
+		if (s && i > INT_MAX) {
+			/* Samples before the start of the array. */
+			if (m > 0u - i)
+				m = 0u - i;
+			memset(x, 0, m * sizeof(x[0]));
+		} else if (s && (i < source->nsamples || source->loop)) {
+			k = i < source->nsamples ? i : i % source->nsamples;
+			if (m > source->nsamples - k)
+				m = source->nsamples - k;
+			for (j = 0; j < m; j++)
+				x[j] = s[k + j];
+		} else if (!s && source->buffer) {
+			k = i & (AAVE_SOURCE_BUFSIZE - 1);
+			if (m > AAVE_SOURCE_BUFSIZE - k)
+				m = AAVE_SOURCE_BUFSIZE - k;
+			memcpy(x, source->buffer + k, m * sizeof(x[0]));
+		} else {
+			/* Past the end of the array, or no samples at all. */
+			memset(x, 0, m * sizeof(x[0]));
+		}
+	}
+}
+
+/**
+ * Stop reading the anechoic samples of @p source from the file mapped by
+ * aave_set_source_file(), if any, and unmap it. The source is then silent.
+ */
+void aave_close_source_file(struct aave_source *source)
+{
+	if (!source->mapping)
+		return;
+
+#ifdef _WIN32
+	free(source->mapping);
+#else
+	munmap(source->mapping, source->mapping_size);
+#endif
+	source->mapping = 0;
+	source->mapping_size = 0;
+	source->samples = 0;
+	source->nsamples = 0;
+	source->silence = AAVE_SOURCE_BUFSIZE;
+}
+
+/**
+ * Read the anechoic samples of @p source from the @p n 16-bit samples
+ * pointed by @p samples, which must remain valid while the source is in
+ * use, starting from the first sample on the next call to aave_get_audio().
+ * The samples are repeated if @p loop is not 0.
+ */
+void aave_set_source_samples(struct aave_source *source, const short *samples,
+						unsigned n, int loop)
+{
+	aave_close_source_stream(source);
+	aave_close_source_file(source);
+
+	/* No ring buffer: aave_alloc_source_buffer() to put samples again. */
+	free(source->buffer);
+	source->buffer = 0;
+
+	source->samples = samples;
+	source->nsamples = n;
+	source->loop = loop && n;
+	source->buffer_index = -1;
+	source->silence = 0;
+}
+
+/**
+ * Find the samples of a 16-bit mono PCM file (RIFF WAVE, or raw with no
+ * header) whose first @p size bytes are pointed by @p p, and store their
+ * offset and length, in bytes, in @p offset and @p length.
+ * The length of the WAVE "data" sub-chunk is not limited to @p size, so
+ * that a file can be parsed from its header only.
+ * Returns 0 on success, or -1 if the file is not in the supported format.
+ */
+int aave_pcm_data(const unsigned char *p, unsigned long size,
+				unsigned long *offset, unsigned long *length)
+{
+	const unsigned char *fmt = 0;
+	unsigned long i, n;
+
+	if (size < 12 || memcmp(p, "RIFF", 4) || memcmp(p + 8, "WAVE", 4)) {
+		/* Raw samples. */
+		*offset = 0;
+		*length = size;
+		return 0;
+	}
+
+	/* Look for the "fmt " and "data" sub-chunks. */
+	for (i = 12; i + 8 <= size; i += 8 + n + (n & 1)) {
+		n = p[i + 4] | p[i + 5] << 8
+			| p[i + 6] << 16 | (unsigned long)p[i + 7] << 24;
+		if (!memcmp(p + i, "fmt ", 4) && n >= 16 && i + 24 <= size)
+			fmt = p + i + 8;
+		if (!memcmp(p + i, "data", 4))
+			break;
+	}
+
+	/* Only 16-bit mono PCM at AAVE_FS is supported. */
+	if (!fmt || i + 8 > size
+	    || (fmt[0] | fmt[1] << 8) != 1
+	    || (fmt[2] | fmt[3] << 8) != 1
+	    || (fmt[4] | fmt[5] << 8 | (unsigned long)fmt[6] << 16) != AAVE_FS
+	    || (fmt[14] | fmt[15] << 8) != 16)
+		return -1;
+
+	*offset = i + 8;
+	*length = n;
+	return 0;
+}
+
+/**
+ * Read the anechoic samples of @p source from the 16-bit mono PCM file
+ * @p filename (RIFF WAVE, or raw with no header), mapped in memory,
+ * as aave_set_source_samples() does. The file remains mapped until the
+ * samples of the source are set again, or aave_close_source_file().
+ * The samples are repeated if @p loop is not 0.
+ * Returns 0 on success, or -1 if the file could not be read or is not
+ * in the supported format.
+ */
+int aave_set_source_file(struct aave_source *source, const char *filename,
+								int loop)
+{
+	const unsigned char *p;
+	unsigned long size, offset, length;
+#ifdef _WIN32
+	unsigned char *data;
+	FILE *f;
+
+	f = fopen(filename, "rb");
+	if (!f)
+		return -1;
+	fseek(f, 0, SEEK_END);
+	size = ftell(f);
+	fseek(f, 0, SEEK_SET);
+	data = malloc(size + 1);
+	if (!data || fread(data, 1, size, f) != size) {
+		free(data);
+		fclose(f);
+		return -1;
+	}
+	fclose(f);
+	p = data;
+#else
+	struct stat st;
+	void *data;
+	int fd;
+
+	fd = open(filename, O_RDONLY);
+	if (fd < 0)
+		return -1;
+	if (fstat(fd, &st) < 0 || st.st_size == 0) {
+		close(fd);
+		return -1;
+	}
+	size = st.st_size;
+	data = mmap(0, size, PROT_READ, MAP_PRIVATE, fd, 0);
+	close(fd);
+	if (data == MAP_FAILED)
+		return -1;
+	p = data;
+#endif
+
+	if (aave_pcm_data(p, size, &offset, &length) < 0) {
+#ifdef _WIN32
+		free(data);
+#else
+		munmap(data, size);
+#endif
+		return -1;
+	}
+
+	if (length > size - offset)
+		length = size - offset;
+	aave_set_source_samples(source, (const short *)(p + offset),
+							length / 2, loop);
+	source->mapping = data;
+	source->mapping_size = size;
+	return 0;
+}
+
+/**
+ * Advance the samples of the sources of the auralisation world @p aave
+ * that are read from memory by @p n frames, as aave_put_audio() would do,
+ * and read the next @p n samples of the streaming sources (see stream.c).
+ * This is called by aave_get_audio() before generating the frames.
+ */
+void aave_advance_sources(struct aave *aave, unsigned n)
+{
+	struct aave_source *source;
+	unsigned i, m;
+
+	for (source = aave->sources; source; source = source->next) {
+		if (source->stream)
+			aave_read_stream(source, n);
+		if (!source->samples)
+			continue;
+
+		i = source->buffer_index + n;
+
+		/*
+		 * Looped samples: keep the index low, but at least the
+		 * maximum delay of the resampler past the start.
+		 */
+		m = AAVE_SOURCE_BUFSIZE * 2;
+		if (source->loop && i <= INT_MAX && i >= m + source->nsamples)
+			i -= (i - m) / source->nsamples * source->nsamples;
+
+		/* Count the trailing silent samples past the end. */
+		source->silence = 0;
+		if (!source->loop && i <= INT_MAX && i >= source->nsamples) {
+			source->silence = i + 1 - source->nsamples;
+			if (source->silence > AAVE_SOURCE_BUFSIZE)
+				source->silence = AAVE_SOURCE_BUFSIZE;
+		}
+
+		source->buffer_index = i;
+	}
+}
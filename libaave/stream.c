@@ -0,0 +1,303 @@
+/*   This file is part of LibAAVE.
+ * 
+ *   LibAAVE is free software: you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation, either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   LibAAVE is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with LibAAVE.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *   Copyright 2014 André Oliveira, Nuno Silva, Guilherme Campos,
+ *   Paulo Dias, José Vieira/IEETA - Universidade de Aveiro
+ *
+ *
+ *   libaave/stream.c: streaming file sound sources
+ */
+
+/**
+ * @file stream.c
+ *
+ * The stream.c file implements the sound sources whose anechoic samples
+ * are streamed from a 16-bit mono PCM file (raw or RIFF WAVE) too large
+ * to be mapped or loaded in memory.
+ *
+ * A reader thread, started by aave_set_source_stream(), reads ahead of
+ * the playback into a single-producer single-consumer lock-free ring of
+ * AAVE_STREAM_BUFSIZE samples, in chunks of AAVE_STREAM_CHUNK samples,
+ * so that there is no disk I/O in the audio thread.
+ * aave_get_audio() moves the samples it needs from this ring to the ring
+ * buffer of the source, allocated by aave_set_source_stream(), with
+ * aave_put_audio(), before generating the frames. If the reader falls behind, the missing samples are silent and
+ * counted as underruns (see aave_get_source_underruns()).
+ *
+ * The reader thread uses POSIX threads (link with -lpthread).
+ */
+
+#include <pthread.h> /* pthread_create() */
+#include <stdatomic.h> /* atomic_load_explicit() */
+#include <stdio.h> /* fopen() */
+#include <stdlib.h> /* calloc() */
+#include <time.h> /* nanosleep() */
+#include "aave.h"
+
+/**
+ * Size of the read-ahead ring of each streaming source, in samples.
+ * Must be a power of 2. 262144 samples are about 6s at 44100Hz.
+ */
+#define AAVE_STREAM_BUFSIZE 262144
+
+/** Number of samples read from the file at a time. */
+#define AAVE_STREAM_CHUNK 16384
+
+/** Time the reader thread waits for room in the ring, in nanoseconds. */
+#define AAVE_STREAM_WAIT 20000000
+
+/**
+ * Data of a streaming sound source.
+ */
+struct aave_stream {
+
+	/** The file the samples are read from. */
+	FILE *file;
+
+	/** Offset of the samples in the file, in bytes. */
+	unsigned long offset;
+
+	/** Length of the samples in the file, in bytes. */
+	unsigned long length;
+
+	/** 1 if the samples are repeated, 0 otherwise. */
+	int loop;
+
+	/** The reader thread. */
+	pthread_t thread;
+
+	/** Set to stop the reader thread. */
+	atomic_int stop;
+
+	/** Set by the reader thread at the end of a file not repeated. */
+	atomic_int end;
+
+	/** Number of samples written to the ring (by the reader thread). */
+	atomic_uint head;
+
+	/** Number of samples read from the ring (by the audio thread). */
+	atomic_uint tail;
+
+	/** Number of samples missing when the audio thread needed them. */
+	unsigned underruns;
+
+	/** Read-ahead ring. */
+	short ring[AAVE_STREAM_BUFSIZE];
+};
+
+/**
+ * Read @p n samples from the file of @p stream into @p buf, from the
+ * start of the samples again at the end of the file if it is repeated.
+ * Returns the number of samples read, which is less than @p n only
+ * at the end of a file not repeated, or on error.
+ */
+static unsigned aave_stream_fread(struct aave_stream *stream, short *buf,
+								unsigned n)
+{
+	unsigned k, i = 0;
+	long position;
+
+	while (i < n) {
+		k = n - i;
+		position = ftell(stream->file);
+		if (position < 0)
+			break;
+		if (position - stream->offset + 2 * k > stream->length)
+			k = (stream->length - (position - stream->offset)) / 2;
+		k = fread(buf + i, 2, k, stream->file);
+		i += k;
+		if (i == n)
+			break;
+		/* End of the samples. */
+		if (!stream->loop || (k == 0 && position == (long)stream->offset)
+		    || fseek(stream->file, stream->offset, SEEK_SET))
+			break;
+	}
+
+	return i;
+}
+
+/**
+ * Reader thread of the streaming source @p arg: keep the ring full.
+ */
+static void *aave_stream_thread(void *arg)
+{
+	struct aave_stream *stream = arg;
+	struct timespec wait = { 0, AAVE_STREAM_WAIT };
+	unsigned head, tail, i, k, n;
+
+	head = atomic_load_explicit(&stream->head, memory_order_relaxed);
+
+	while (!atomic_load_explicit(&stream->stop, memory_order_relaxed)) {
+		tail = atomic_load_explicit(&stream->tail,
+						memory_order_acquire);
+		if (AAVE_STREAM_BUFSIZE - (head - tail) < AAVE_STREAM_CHUNK) {
+			nanosleep(&wait, 0);
+			continue;
+		}
+
+		/* Read one chunk, in up to 2 parts, due to the wrap-around. */
+		i = head & (AAVE_STREAM_BUFSIZE - 1);
+		k = AAVE_STREAM_BUFSIZE - i;
+		if (k > AAVE_STREAM_CHUNK)
+			k = AAVE_STREAM_CHUNK;
+		n = aave_stream_fread(stream, stream->ring + i, k);
+		if (n == k && k < AAVE_STREAM_CHUNK)
+			n += aave_stream_fread(stream, stream->ring,
+						AAVE_STREAM_CHUNK - k);
+
+		head += n;
+		atomic_store_explicit(&stream->head, head, memory_order_release);
+
+		if (n < AAVE_STREAM_CHUNK) {
+			atomic_store_explicit(&stream->end, 1,
+						memory_order_release);
+			break;
+		}
+	}
+
+	return 0;
+}
+
+/**
+ * Stream the anechoic samples of @p source from the 16-bit mono PCM file
+ * @p filename (RIFF WAVE, or raw with no header), read ahead by a reader
+ * thread, starting on the next call to aave_get_audio().
+ * The samples are repeated if @p loop is not 0.
+ * The ring buffer of the source is allocated here, rather than on the
+ * first call to aave_get_audio(), so that the audio thread does not
+ * allocate memory.
+ * Returns 0 on success, or -1 if the file could not be read or is not
+ * in the supported format, the reader thread could not be started, or
+ * out of memory.
+ */
+int aave_set_source_stream(struct aave_source *source, const char *filename,
+								int loop)
+{
+	struct aave_stream *stream;
+	unsigned char header[4096];
+	unsigned long size;
+
+	if (!source->buffer && !aave_alloc_source_buffer(source))
+		return -1;
+
+	stream = calloc(1, sizeof *stream);
+	if (!stream)
+		return -1;
+
+	stream->file = fopen(filename, "rb");
+	if (!stream->file) {
+		free(stream);
+		return -1;
+	}
+
+	/* Parse the header. */
+	size = fread(header, 1, sizeof header, stream->file);
+	if (aave_pcm_data(header, size, &stream->offset, &stream->length) < 0
+	    || fseek(stream->file, stream->offset, SEEK_SET)) {
+		fclose(stream->file);
+		free(stream);
+		return -1;
+	}
+	/* Raw samples: read up to the end of the file. */
+	if (stream->offset == 0)
+		stream->length = -1;
+	stream->loop = loop;
+
+	if (pthread_create(&stream->thread, 0, aave_stream_thread, stream)) {
+		fclose(stream->file);
+		free(stream);
+		return -1;
+	}
+
+	aave_close_source_stream(source);
+	aave_close_source_file(source);
+	source->samples = 0;
+	source->stream = stream;
+	return 0;
+}
+
+/**
+ * Stop streaming the samples of @p source, if it was streaming, stopping
+ * its reader thread and closing its file.
+ * This frees the stream that aave_get_audio() reads from, so it must not
+ * be called while aave_get_audio() runs (neither must
+ * aave_set_source_stream() and aave_set_source_samples(), which call it).
+ */
+void aave_close_source_stream(struct aave_source *source)
+{
+	struct aave_stream *stream = source->stream;
+
+	if (!stream)
+		return;
+
+	atomic_store_explicit(&stream->stop, 1, memory_order_relaxed);
+	pthread_join(stream->thread, 0);
+	fclose(stream->file);
+	free(stream);
+	source->stream = 0;
+}
+
+/**
+ * Return the number of samples of the streaming @p source that were not
+ * read ahead in time and were played as silence.
+ */
+unsigned aave_get_source_underruns(const struct aave_source *source)
+{
+	return source->stream ? source->stream->underruns : 0;
+}
+
+/**
+ * Move the next @p n samples of the streaming @p source from the read-ahead
+ * ring to the ring buffer of the source, or silence if they are missing.
+ * This is called by aave_get_audio() before generating the frames.
+ */
+void aave_read_stream(struct aave_source *source, unsigned n)
+{
+	struct aave_stream *stream = source->stream;
+	static const short zero[AAVE_STREAM_CHUNK];
+	unsigned head, tail, i, k;
+	int end;
+
+	/* Load the end flag before the head, which is final at the end. */
+	end = atomic_load_explicit(&stream->end, memory_order_acquire);
+	head = atomic_load_explicit(&stream->head, memory_order_acquire);
+	tail = atomic_load_explicit(&stream->tail, memory_order_relaxed);
+
+	while (n) {
+		k = head - tail;
+		if (k == 0) {
+			/* Past the end, or underrun: silence. */
+			k = n < AAVE_STREAM_CHUNK ? n : AAVE_STREAM_CHUNK;
+			aave_put_audio(source, zero, k);
+			if (!end)
+				stream->underruns += k;
+			n -= k;
+			continue;
+		}
+
+		/* Up to 2 parts, due to the wrap-around. */
+		i = tail & (AAVE_STREAM_BUFSIZE - 1);
+		if (k > AAVE_STREAM_BUFSIZE - i)
+			k = AAVE_STREAM_BUFSIZE - i;
+		if (k > n)
+			k = n;
+		aave_put_audio(source, stream->ring + i, k);
+		tail += k;
+		n -= k;
+	}
+
+	atomic_store_explicit(&stream->tail, tail, memory_order_release);
+}
@@ -0,0 +1,84 @@
+/*   This file is part of LibAAVE.
+ * 
+ *   LibAAVE is free software: you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation, either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   LibAAVE is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with LibAAVE.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *   Copyright 2014 André Oliveira, Nuno Silva, Guilherme Campos,
+ *   Paulo Dias, José Vieira/IEETA - Universidade de Aveiro
+ *
+ *
+ *   libaave/tests/dftradix.c: test that the radix-4 and radix-2 passes
+ *   of dft() and idft() give the same results
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "aave.h"
+
+/* Radix-4 dft() and idft(), the default. */
+#define dft dft_radix4
+#define idft idft_radix4
+#define idft_passes idft_passes_radix4
+#define DFT_TYPE short
+#include "../dft.h"
+#define IDFT_TYPE int
+#include "../idft.h"
+#undef DFT_TYPE
+#undef IDFT_TYPE
+#undef dft
+#undef idft
+#undef idft_passes
+
+/* Radix-2 dft() and idft(), for reference. */
+#define AAVE_DFT_RADIX2
+#define dft dft_radix2
+#define idft idft_radix2
+#define idft_passes idft_passes_radix2
+#define DFT_TYPE short
+#include "../dft.h"
+#define IDFT_TYPE int
+#include "../idft.h"
+
+/** The largest size supported by the dftsincos table. */
+#define N 4096
+
+int main()
+{
+	static short x[N/2];
+	static float X2[N], X4[N];
+	static int y2[N], y4[N];
+	unsigned i, n;
+	int failed = 0;
+
+	for (i = 0; i < N/2; i++)
+		x[i] = rand() % 65536 - 32768;
+
+	for (n = 8; n <= N; n *= 2) {
+		dft_radix2(X2, x, n);
+		dft_radix4(X4, x, n);
+		if (memcmp(X2, X4, n * sizeof X2[0])) {
+			fprintf(stderr, "dft N=%u differs\n", n);
+			failed = 1;
+		}
+
+		idft_radix2(y2, X2, n);
+		idft_radix4(y4, X4, n);
+		if (memcmp(y2, y4, n * sizeof y2[0])) {
+			fprintf(stderr, "idft N=%u differs\n", n);
+			failed = 1;
+		}
+	}
+
+	return failed;
+}
@@ -0,0 +1,109 @@
+/*   This file is part of LibAAVE.
+ * 
+ *   LibAAVE is free software: you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation, either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   LibAAVE is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with LibAAVE.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *   Copyright 2014 André Oliveira, Nuno Silva, Guilherme Campos,
+ *   Paulo Dias, José Vieira/IEETA - Universidade de Aveiro
+ *
+ *
+ *   libaave/tests/hrtflookup.c: test that the direction lookup table gives
+ *   the HRTF pairs of hrtf_get()
+ */
+
+
+#include <math.h>	/* cos(), fabsf(), sin(), sqrt() */
+#include <stdio.h>	/* printf() */
+#include <stdlib.h>	/* calloc() */
+#include "../../libaave/aave.h"
+
+/* The step of the sweep of the directions, in degrees. */
+#define STEP 0.1
+
+/*
+ * Return 1 if the direction lookup table of @p aave gives the pair of
+ * hrtf_get() for the angles of the unit vector @p v, or 0 otherwise.
+ */
+static int check(const struct aave *aave, const float v[3])
+{
+	const aave_spectrum *hrtf[2];
+	const float *pair[2];
+	float elevation, azimuth, delay[2];
+
+	aave_get_angles(v, &elevation, &azimuth);
+	aave->hrtf_get(aave, pair, elevation * (180/M_PI),
+						azimuth * (180/M_PI));
+	aave_hrtf_lookup(aave, v, hrtf, delay);
+#ifdef AAVE_BF16
+	/* The bfloat16 copies are in the order of the spectra. */
+	return aave->hrtf_lookup->spectra[(hrtf[0] - aave->hrtf_lookup->data)
+			/ (aave->hrtf_frames * 4)] == pair[0]
+		&& aave->hrtf_lookup->spectra[(hrtf[1] - aave->hrtf_lookup->data)
+			/ (aave->hrtf_frames * 4)] == pair[1];
+#else
+	return hrtf[0] == pair[0] && hrtf[1] == pair[1];
+#endif
+}
+
+/*
+ * Compare the HRTF pairs of the direction lookup table of the CIPIC set
+ * with those of its hrtf_get() over a sweep of the elevations and azimuths
+ * in steps of STEP degrees, and along the edges of the cells of the table.
+ */
+int main()
+{
+	struct aave *aave;
+	unsigned i, j, n = 0, bad = 0;
+	float v[3], e, a, x, y, t;
+
+	aave = calloc(1, sizeof *aave);
+	aave_hrtf_cipic(aave);
+
+	for (i = 0; i <= 180 / STEP; i++) {
+		for (j = 0; j <= 360 / STEP; j++) {
+			e = (i * STEP - 90) * (M_PI / 180);
+			a = (j * STEP - 180) * (M_PI / 180);
+			v[0] = cos(e) * cos(a);
+			v[1] = -cos(e) * sin(a);
+			v[2] = -sin(e);
+			bad += !check(aave, v);
+			n++;
+		}
+	}
+
+	/* Just inside each side of the edges of the cells. */
+	for (i = 0; i <= AAVE_HRTF_LOOKUP_SIZE * 2; i++) {
+		for (j = 0; j < 4096; j++) {
+			x = (i / 2 + (i % 2 ? 1e-5 : -1e-5))
+				* (2. / AAVE_HRTF_LOOKUP_SIZE) - 1;
+			y = j * (2. / 4096) - 1;
+			v[0] = j % 2 ? x : y;
+			v[1] = j % 2 ? y : x;
+			v[2] = 1 - fabsf(x) - fabsf(y);
+			if (v[2] < 0) {
+				t = v[0];
+				v[0] = (1 - fabsf(v[1])) * (t < 0 ? -1 : 1);
+				v[1] = (1 - fabsf(t)) * (v[1] < 0 ? -1 : 1);
+			}
+			t = sqrt(v[0] * v[0] + v[1] * v[1] + v[2] * v[2]);
+			v[0] /= t;
+			v[1] /= t;
+			v[2] /= t;
+			bad += !check(aave, v);
+			n++;
+		}
+	}
+
+	printf("%u of %u directions differ\n", bad, n);
+	return bad != 0;
+}
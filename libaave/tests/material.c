@@ -44,6 +44,7 @@ int main()
 	struct aave *aave;
 	struct aave_surface **surfaces;
 	unsigned i, j, n;
+	aave_spectrum filter[N * 4];
 	float x[N * 4];
 
 	/* Create auralisation engine. */
@@ -71,7 +72,8 @@ int main()
 	}
 
 	/* Design the total material absortion filter. */
-	aave_get_material_filter(aave, surfaces, n, x);
+	aave_get_material_filter(aave, surfaces, n, filter);
+	aave_spectrum_load(x, filter, N * 4);
 #if 1
 	/* Print the frequency response of the designed filter. */
 	printf("x = [ %e", x[0]);
@@ -0,0 +1,84 @@
+/*   This file is part of LibAAVE.
+ * 
+ *   LibAAVE is free software: you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation, either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   LibAAVE is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with LibAAVE.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *   Copyright 2014 André Oliveira, Nuno Silva, Guilherme Campos,
+ *   Paulo Dias, José Vieira/IEETA - Universidade de Aveiro
+ *
+ *
+ *   libaave/tests/reverbconv.c: test the partitioned convolution reverberator
+ */
+
+#include <math.h>	/* fabs() */
+#include <stdio.h>	/* printf() */
+#include <stdlib.h>	/* calloc(), rand() */
+#include "../../libaave/aave.h"
+
+/* The length of the input. */
+#define N 20000
+
+/* The length of the impulse response. */
+#define M 9000
+
+/*
+ * Compare the output of the convolution reverberator, for a random input
+ * and impulse response, processed in random block sizes, with the direct
+ * convolution, delayed by AAVE_REVERB_CONV_BLOCK samples.
+ */
+int main()
+{
+	struct aave *aave;
+	struct aave_reverb *rev;
+	static float x[N], h[2][M], y[N * 2];
+	unsigned i, k, n, c;
+	double z, e, emax = 0;
+
+	for (i = 0; i < N; i++)
+		x[i] = rand() % 2000 - 1000;
+	for (i = 0; i < M; i++) {
+		h[0][i] = (rand() % 2000 - 1000) / 1000.;
+		h[1][i] = (rand() % 2000 - 1000) / 1000.;
+	}
+
+	aave = calloc(1, sizeof *aave);
+	aave_reverb_init(aave);
+	rev = aave->reverb;
+	rev->mix = 1;
+	rev->level = 1;
+	aave_reverb_conv_set_ir(aave, h[0], h[1], M);
+
+	/* Swap it in, as the audio thread does before its next block. */
+	aave_reverb_apply(rev);
+
+	for (i = 0; i < N; i += n) {
+		n = rand() % 700 + 1;
+		if (n > N - i)
+			n = N - i;
+		aave_reverb_conv(rev, x + i, y + i * 2, n);
+	}
+
+	for (c = 0; c < 2; c++) {
+		for (i = 0; i < N; i++) {
+			z = 0;
+			for (k = 0; k < M && k + AAVE_REVERB_CONV_BLOCK <= i; k++)
+				z += h[c][k] * x[i - k - AAVE_REVERB_CONV_BLOCK];
+			e = fabs(y[i * 2 + c] - z);
+			if (e > emax)
+				emax = e;
+		}
+	}
+
+	printf("maximum error = %e\n", emax);
+	return emax > 1;
+}
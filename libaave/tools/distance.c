@@ -0,0 +1,58 @@
+/*   This file is part of LibAAVE.
+ * 
+ *   LibAAVE is free software: you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation, either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   LibAAVE is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with LibAAVE.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *   Copyright 2014 André Oliveira, Nuno Silva, Guilherme Campos,
+ *   Paulo Dias, José Vieira/IEETA - Universidade de Aveiro
+ *
+ *
+ *   libaave/tools/distance.c: generate decay table for the resampler
+ */
+
+/*
+ * Usage: ./distance B1 N > ../distance.c
+ *
+ * B1 must be the AAVE_DISTANCE_B1 coefficient of audio.c, and N twice
+ * AAVE_MAX_HRTF, the largest audio block, for example:
+ * ./distance 0.99977 4096 > ../distance.c
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+
+int main(int argc, char **argv)
+{
+	unsigned i, n;
+	double b1;
+
+	if (argc != 3) {
+		fprintf(stderr, "Usage: %s B1 N\n", argv[0]);
+		return 1;
+	}
+
+	b1 = atof(argv[1]);
+	n = atoi(argv[2]);
+
+	printf("/* This file was automatically generated."
+		" See tools/distance.c */\n"
+		"const float aave_distance_decay[]={");
+
+	for (i = 0; i < n; i++)
+		printf("%e,", pow(b1, i + 1));
+
+	printf("};\n");
+
+	return 0;
+}
@@ -0,0 +1,161 @@
+/*   This file is part of LibAAVE.
+ * 
+ *   LibAAVE is free software: you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation, either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   LibAAVE is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with LibAAVE.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *   Copyright 2014 André Oliveira, Nuno Silva, Guilherme Campos,
+ *   Paulo Dias, José Vieira/IEETA - Universidade de Aveiro
+ *
+ *
+ *   libaave/tools/hrtf_file.c: write an HRTF set of libaave to an HRTF file
+ *   Usage: ./hrtf_file [-m frames] cipic|listen|mit|tub [step] > set.hrtf
+ *   Build: cc -o hrtf_file hrtf_file.c ../libaave.a -lm -lpthread
+ *
+ *   With -m, the HRTFs are decomposed into minimum-phase HRTFs of the
+ *   given number of frames and delays (see ../hrtf_minphase.c), which are
+ *   written after the spectra, relative to the smallest one.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h> /* getopt() */
+#include "../aave.h"
+
+/* Maximum number of distinct spectra of a set. */
+#define MAX_SPECTRA 4096
+
+/* Alignment of the spectra in the file (page size). */
+#define ALIGN 4096
+
+int main(int argc, char **argv)
+{
+	static struct aave aave;
+	static const float *spectra[MAX_SPECTRA];
+	static float delays[MAX_SPECTRA], y[AAVE_MAX_HRTF * 4];
+	struct aave_hrtf_file_header h;
+	const float *hrtf[2];
+	unsigned (*index)[2];
+	unsigned i, c, n, e, a, step, azimuths, length = 0;
+	long pos;
+	float min;
+	int opt;
+
+	while ((opt = getopt(argc, argv, "m:")) != -1) {
+		if (opt != 'm')
+			goto usage;
+		length = atoi(optarg);
+	}
+	if (optind >= argc)
+		goto usage;
+	if (!strcmp(argv[optind], "cipic"))
+		aave_hrtf_cipic(&aave);
+	else if (!strcmp(argv[optind], "listen"))
+		aave_hrtf_listen(&aave);
+	else if (!strcmp(argv[optind], "mit"))
+		aave_hrtf_mit(&aave);
+	else if (!strcmp(argv[optind], "tub"))
+		aave_hrtf_tub(&aave);
+	else {
+		fprintf(stderr, "unknown HRTF set %s\n", argv[optind]);
+		return 1;
+	}
+	if (length && (length < 2 || length > aave.hrtf_frames
+		       || (length & (length - 1)))) {
+		fprintf(stderr, "frames must be a power of 2 up to %u\n",
+							aave.hrtf_frames);
+		return 1;
+	}
+
+	step = argc > optind + 1 ? atoi(argv[optind + 1]) : 1;
+	if (!step || 90 % step) {
+		fprintf(stderr, "the step must divide 90 degrees\n");
+		return 1;
+	}
+	azimuths = 360 / step + 1;
+	index = malloc((180 / step + 1) * azimuths * sizeof *index);
+	if (!index) {
+		perror("malloc");
+		return 1;
+	}
+
+	/* Sample the directions of the grid, and collect the spectra. */
+	n = 0;
+	for (e = 0; e <= 180 / step; e++) {
+		for (a = 0; a < azimuths; a++) {
+			aave.hrtf_get(&aave, hrtf, (int)(e * step) - 90,
+						(int)(a * step) - 180);
+			for (c = 0; c < 2; c++) {
+				for (i = 0; i < n && spectra[i] != hrtf[c]; i++)
+					;
+				if (i == n) {
+					if (n == MAX_SPECTRA) {
+						fprintf(stderr,
+							"too many spectra\n");
+						return 1;
+					}
+					spectra[n++] = hrtf[c];
+				}
+				index[e * azimuths + a][c] = i;
+			}
+		}
+	}
+
+	memset(&h, 0, sizeof h);
+	memcpy(h.magic, "AAVEHRTF", 8);
+	h.version = AAVE_HRTF_FILE_VERSION;
+	h.frames = length ? length : aave.hrtf_frames;
+	h.count = n;
+	h.step = step;
+	pos = sizeof h + (180 / step + 1) * azimuths * sizeof *index;
+	h.offset = (pos + ALIGN - 1) / ALIGN * ALIGN;
+	if (length)
+		h.delays = h.offset + n * h.frames * 4 * sizeof(float);
+
+	fwrite(&h, sizeof h, 1, stdout);
+	fwrite(index, sizeof *index, (180 / step + 1) * azimuths, stdout);
+	for (; pos < (long)h.offset; pos++)
+		putchar(0);
+	for (i = 0; i < n; i++) {
+		if (!length) {
+			fwrite(spectra[i], sizeof(float), h.frames * 4, stdout);
+			continue;
+		}
+		delays[i] = aave_hrtf_minimum_phase(y, length, spectra[i],
+							aave.hrtf_frames);
+		fwrite(y, sizeof(float), h.frames * 4, stdout);
+	}
+
+	/* The delays, relative to the smallest one. */
+	if (length) {
+		min = delays[0];
+		for (i = 1; i < n; i++)
+			if (delays[i] < min)
+				min = delays[i];
+		for (i = 0; i < n; i++)
+			delays[i] -= min;
+		fwrite(delays, sizeof(float), n, stdout);
+	}
+
+	if (fflush(stdout)) {
+		perror("write");
+		return 1;
+	}
+	fprintf(stderr, "%u spectra of %u frames\n", n, h.frames);
+	return 0;
+
+usage:
+	fprintf(stderr, "usage: %s [-m frames] cipic|listen|mit|tub [step]\n",
+								argv[0]);
+	return 1;
+}
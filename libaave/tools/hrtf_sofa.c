@@ -0,0 +1,351 @@
+/*   This file is part of LibAAVE.
+ * 
+ *   LibAAVE is free software: you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation, either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   LibAAVE is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with LibAAVE.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *   Copyright 2014 André Oliveira, Nuno Silva, Guilherme Campos,
+ *   Paulo Dias, José Vieira/IEETA - Universidade de Aveiro
+ *
+ *
+ *   libaave/tools/hrtf_sofa.c: convert a SOFA HRIR set to an HRTF file
+ *   Usage: ./hrtf_sofa [-n frames] [-w] [-m] [-s step] set.sofa > set.hrtf
+ *   Build: cc -o hrtf_sofa hrtf_sofa.c ../hrtf_minphase.c ../dftsincos.c \
+ *          -I/usr/include/hdf5/serial -lhdf5_serial -lm
+ *
+ *   Reads the head-related impulse responses (HRIR) of a SOFA file
+ *   (AES69, SimpleFreeFieldHRIR convention, an HDF5 file), resamples them
+ *   to AAVE_FS, if needed, applies their broadband delays, truncates them
+ *   to the target number of frames (-n, a power of 2, by default that of
+ *   the HRIRs), optionally with a half-Hann fade-out over its last quarter
+ *   (-w), and writes their spectra, in the layout of dft.h, with a direction
+ *   index of step -s degrees (1 by default), to an HRTF file (see
+ *   ../hrtf_file.c). Each direction of the index gets the nearest measured
+ *   direction.
+ *
+ *   With -m, the whole HRIRs are decomposed into minimum-phase HRTFs and
+ *   delays (see ../hrtf_minphase.c), and the minimum-phase HRTFs are
+ *   truncated to the target number of frames (256 by default), while the
+ *   delays, relative to the smallest one, are written after the spectra.
+ *   The minimum-phase HRIRs are always faded out over their last quarter
+ *   after the truncation, so -w does not apply to the whole HRIRs.
+ */
+
+#include <hdf5.h>
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h> /* getopt() */
+#include "../aave.h"
+
+#define DFT_TYPE float
+#include "../dft.h"
+
+/* Alignment of the spectra in the file (page size). */
+#define ALIGN 4096
+
+/* Half length of the windowed sinc interpolator of the resampler. */
+#define SINC_TAPS 32
+
+/*
+ * Read the dataset @p name of the SOFA file @p file as doubles, and its
+ * dimensions in @p dims (up to 3, the others 1).
+ * Returns the values, or NULL if the dataset does not exist.
+ */
+static double *read_dataset(hid_t file, const char *name, hsize_t dims[3])
+{
+	hid_t set, space;
+	hsize_t n = 1;
+	double *x;
+	int i, rank;
+
+	dims[0] = dims[1] = dims[2] = 1;
+	if (!H5Lexists(file, name, H5P_DEFAULT))
+		return NULL;
+	set = H5Dopen2(file, name, H5P_DEFAULT);
+	if (set < 0)
+		return NULL;
+	space = H5Dget_space(set);
+	rank = H5Sget_simple_extent_ndims(space);
+	if (rank > 3) {
+		fprintf(stderr, "%s: too many dimensions\n", name);
+		exit(1);
+	}
+	H5Sget_simple_extent_dims(space, dims, NULL);
+	for (i = 0; i < rank; i++)
+		n *= dims[i];
+	x = malloc(n * sizeof *x);
+	if (!x || H5Dread(set, H5T_NATIVE_DOUBLE, H5S_ALL, H5S_ALL,
+						H5P_DEFAULT, x) < 0) {
+		fprintf(stderr, "%s: read error\n", name);
+		exit(1);
+	}
+	H5Sclose(space);
+	H5Dclose(set);
+
+	return x;
+}
+
+/*
+ * Return 1 if the positions of the dataset @p name of the SOFA file
+ * @p file are cartesian, 0 if they are spherical.
+ */
+static int cartesian(hid_t file, const char *name)
+{
+	char type[64] = "";
+	hid_t set, attr, t;
+
+	set = H5Dopen2(file, name, H5P_DEFAULT);
+	if (set < 0 || !H5Aexists(set, "Type"))
+		return 0;
+	attr = H5Aopen(set, "Type", H5P_DEFAULT);
+	t = H5Aget_type(attr);
+	if (H5Tget_class(t) == H5T_STRING && !H5Tis_variable_str(t)
+	    && H5Tget_size(t) < sizeof type)
+		H5Aread(attr, t, type);
+	H5Tclose(t);
+	H5Aclose(attr);
+	H5Dclose(set);
+
+	return !strncmp(type, "cartesian", 9);
+}
+
+/*
+ * Resample the @p n samples pointed by @p x, at @p fs Hz, to @p m samples
+ * at AAVE_FS Hz in @p y, with a Hann windowed sinc interpolator, delayed
+ * by @p delay samples at @p fs Hz.
+ */
+static void resample(float *y, unsigned m, const double *x, unsigned n,
+						double fs, double delay)
+{
+	double r = fs / AAVE_FS, c = r > 1 ? 1 / r : 1, t, s, u, w;
+	unsigned i;
+	int j, k;
+
+	for (i = 0; i < m; i++) {
+		t = i * r - delay;
+		k = floor(t);
+		s = 0;
+		for (j = k - SINC_TAPS + 1; j <= k + SINC_TAPS; j++) {
+			if (j < 0 || j >= (int)n)
+				continue;
+			u = (t - j) * c;
+			w = 0.5 + 0.5 * cos(M_PI * (t - j) / (SINC_TAPS + 1));
+			s += x[j] * c * w * (u == 0 ? 1
+					: sin(M_PI * u) / (M_PI * u));
+		}
+		y[i] = s;
+	}
+}
+
+int main(int argc, char **argv)
+{
+	struct aave_hrtf_file_header h;
+	hid_t file;
+	hsize_t dims[3], ddims[3], pdims[3], rdims[3];
+	double *ir, *pos, *delay, *rate, fs, v[3], best, d, *dir;
+	float *hrir, *hrtf, *y, *delays, min;
+	unsigned (*index)[2];
+	unsigned frames = 0, step = 1, window = 0, i, j, m, e, a, c, azimuths;
+	unsigned n, count, length, full, minphase = 0, spherical;
+	long offset;
+	int opt;
+
+	while ((opt = getopt(argc, argv, "mn:s:w")) != -1) {
+		switch (opt) {
+		case 'm':
+			minphase = 1;
+			break;
+		case 'n':
+			frames = atoi(optarg);
+			break;
+		case 's':
+			step = atoi(optarg);
+			break;
+		case 'w':
+			window = 1;
+			break;
+		default:
+			goto usage;
+		}
+	}
+	if (optind != argc - 1)
+		goto usage;
+	if (frames && (frames > AAVE_MAX_HRTF || (frames & (frames - 1)))) {
+		fprintf(stderr, "frames must be a power of 2 up to %u\n",
+							AAVE_MAX_HRTF);
+		return 1;
+	}
+	if (!step || 90 % step) {
+		fprintf(stderr, "the step must divide 90 degrees\n");
+		return 1;
+	}
+
+	file = H5Fopen(argv[optind], H5F_ACC_RDONLY, H5P_DEFAULT);
+	if (file < 0) {
+		fprintf(stderr, "error opening file %s\n", argv[optind]);
+		return 1;
+	}
+
+	/* Data.IR is [measurements][receivers][samples]. */
+	ir = read_dataset(file, "Data.IR", dims);
+	pos = read_dataset(file, "SourcePosition", pdims);
+	rate = read_dataset(file, "Data.SamplingRate", rdims);
+	delay = read_dataset(file, "Data.Delay", ddims);
+	if (!ir || !pos || !rate || dims[1] != 2 || pdims[1] != 3
+	    || (pdims[0] != dims[0] && pdims[0] != 1)) {
+		fprintf(stderr, "not a SOFA SimpleFreeFieldHRIR file\n");
+		return 1;
+	}
+	m = dims[0];
+	fs = rate[0];
+
+	/* Unit vectors of the measured directions, in the axes of libaave. */
+	dir = malloc(m * 3 * sizeof *dir);
+	if (!dir) {
+		perror("malloc");
+		return 1;
+	}
+	spherical = !cartesian(file, "SourcePosition");
+	for (i = 0; i < m; i++) {
+		memcpy(v, pos + (pdims[0] == 1 ? 0 : i) * 3, sizeof v);
+		if (spherical) {
+			/* Azimuth counterclockwise, elevation, distance. */
+			v[0] *= M_PI / 180;
+			v[1] *= M_PI / 180;
+			d = cos(v[1]);
+			v[2] = sin(v[1]);
+			v[1] = d * sin(v[0]);
+			v[0] = d * cos(v[0]);
+		}
+		d = sqrt(v[0] * v[0] + v[1] * v[1] + v[2] * v[2]);
+		for (j = 0; j < 3; j++)
+			dir[i * 3 + j] = d > 0 ? v[j] / d : 0;
+	}
+	H5Fclose(file);
+
+	/*
+	 * Length of the HRIRs at AAVE_FS, and the number of frames, of the
+	 * file and, for the minimum-phase decomposition, of the whole HRIRs.
+	 */
+	length = ceil(dims[2] * AAVE_FS / fs);
+	for (full = 2; full < length && full < AAVE_MAX_HRTF; )
+		full *= 2;
+	if (!frames)
+		frames = minphase && full > 256 ? 256 : full;
+	if (!minphase)
+		full = frames;
+	else if (frames > full) {
+		fprintf(stderr, "frames must be up to %u\n", full);
+		return 1;
+	}
+	n = frames * 4;
+
+	hrir = calloc(full * 2, sizeof *hrir);
+	hrtf = malloc(full * 4 * sizeof *hrtf);
+	y = malloc(n * sizeof *y);
+	delays = malloc(m * 2 * sizeof *delays);
+	azimuths = 360 / step + 1;
+	count = (180 / step + 1) * azimuths;
+	index = malloc(count * sizeof *index);
+	if (!hrir || !hrtf || !y || !delays || !index) {
+		perror("malloc");
+		return 1;
+	}
+
+	/* Nearest measured direction of each direction of the index. */
+	for (e = 0; e <= 180 / step; e++) {
+		for (a = 0; a < azimuths; a++) {
+			/* libaave azimuths are clockwise. */
+			v[0] = cos((e * step - 90.) * M_PI / 180)
+				* cos((a * step - 180.) * M_PI / 180);
+			v[1] = - cos((e * step - 90.) * M_PI / 180)
+				* sin((a * step - 180.) * M_PI / 180);
+			v[2] = sin((e * step - 90.) * M_PI / 180);
+			best = -2;
+			j = 0;
+			for (i = 0; i < m; i++) {
+				d = v[0] * dir[i * 3] + v[1] * dir[i * 3 + 1]
+						+ v[2] * dir[i * 3 + 2];
+				if (d > best) {
+					best = d;
+					j = i;
+				}
+			}
+			index[e * azimuths + a][0] = j * 2;
+			index[e * azimuths + a][1] = j * 2 + 1;
+		}
+	}
+
+	memset(&h, 0, sizeof h);
+	memcpy(h.magic, "AAVEHRTF", 8);
+	h.version = AAVE_HRTF_FILE_VERSION;
+	h.frames = frames;
+	h.count = m * 2;
+	h.step = step;
+	offset = sizeof h + count * sizeof *index;
+	h.offset = (offset + ALIGN - 1) / ALIGN * ALIGN;
+	if (minphase)
+		h.delays = h.offset + m * 2 * n * sizeof(float);
+
+	fwrite(&h, sizeof h, 1, stdout);
+	fwrite(index, sizeof *index, count, stdout);
+	for (; offset < (long)h.offset; offset++)
+		putchar(0);
+
+	/* The spectra: left and right of each measurement. */
+	for (i = 0; i < m; i++) {
+		for (c = 0; c < 2; c++) {
+			d = delay ? delay[(ddims[0] == 1 ? 0 : i) * ddims[1]
+				+ (ddims[1] == 1 ? 0 : c)] : 0;
+			resample(hrir, full, ir + (i * 2 + c) * dims[2],
+							dims[2], fs, d);
+			if (window && !minphase)
+				for (j = full * 3 / 4; j < full; j++)
+					hrir[j] *= 0.5 + 0.5 * cos(M_PI
+						* (j - full * 3 / 4.)
+						/ (full / 4.));
+			dft(hrtf, hrir, full * 4);
+			if (minphase) {
+				delays[i * 2 + c] = aave_hrtf_minimum_phase(y,
+						frames, hrtf, full);
+				fwrite(y, sizeof *y, n, stdout);
+			} else
+				fwrite(hrtf, sizeof *hrtf, n, stdout);
+		}
+	}
+
+	/* The delays, relative to the smallest one. */
+	if (minphase) {
+		min = delays[0];
+		for (i = 1; i < m * 2; i++)
+			if (delays[i] < min)
+				min = delays[i];
+		for (i = 0; i < m * 2; i++)
+			delays[i] -= min;
+		fwrite(delays, sizeof *delays, m * 2, stdout);
+	}
+
+	if (fflush(stdout)) {
+		perror("write");
+		return 1;
+	}
+	fprintf(stderr, "%u measurements, %u frames at %u Hz\n", m, frames,
+								AAVE_FS);
+	return 0;
+
+usage:
+	fprintf(stderr, "usage: %s [-n frames] [-w] [-m] [-s step] set.sofa\n",
+								argv[0]);
+	return 1;
+}